@@ -0,0 +1,24 @@
+#include "Bench.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// The replacement operators live alone in this file: inlined next to code that
+// calls the global operator new, GCC would flag their free() as a mismatched
+// deallocation (-Wmismatched-new-delete).
+
+static std::atomic<uint64_t> s_Allocations{0};
+
+void* operator new(std::size_t size)
+{
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void  operator delete(void* p) noexcept              { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace Bench {
+
+    uint64_t Allocations() { return s_Allocations.load(std::memory_order_relaxed); }
+}
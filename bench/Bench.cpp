@@ -0,0 +1,225 @@
+#include "Bench.h"
+#include "Corpus.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <nlohmann/json.hpp>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace Bench {
+
+    struct Entry {
+        const char* Name;
+        BenchFn     Fn;
+        bool        Sized;
+    };
+
+    static std::vector<Entry>& Registry()
+    {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    struct ExtraOption {
+        const char*  Name;
+        std::string* Value;
+        const char*  Help;
+    };
+
+    // Filled by static registrars in other files, hence not a plain static
+    static std::vector<ExtraOption>& ExtraOptions()
+    {
+        static std::vector<ExtraOption> options;
+        return options;
+    }
+
+    static Options             s_Options;
+    static std::vector<Result> s_Results;
+
+    const Options& GetOptions() { return s_Options; }
+
+    int Iterations(int full)
+    {
+        return s_Options.Quick ? std::max(1, full / 10) : full;
+    }
+
+    size_t ResidentBytes()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+        return counters.WorkingSetSize;
+#else
+        // Second field of statm: resident pages
+        std::ifstream statm("/proc/self/statm");
+        size_t total = 0, resident = 0;
+        if (!(statm >> total >> resident)) return 0;
+        return resident * (size_t)sysconf(_SC_PAGESIZE);
+#endif
+    }
+
+    void AddOption(const char* name, std::string* value, const char* help)
+    {
+        ExtraOptions().push_back({ name, value, help });
+    }
+
+    Registrar::Registrar(const char* name, BenchFn fn, bool sized)
+    {
+        Registry().push_back({ name, fn, sized });
+    }
+
+    Result Measure(const std::string& name, int size, int iterations,
+                   const std::function<void()>& fn, bool warmup)
+    {
+        if (warmup) fn();
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        uint64_t allocs = Allocations();
+        for (int i = 0; i < iterations; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            samples.push_back(std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count());
+        }
+        allocs = Allocations() - allocs;
+        return Summarize(name, size, std::move(samples), allocs);
+    }
+
+    Result Summarize(const std::string& name, int size, std::vector<double> samples, uint64_t allocs)
+    {
+        Result r;
+        r.Name       = name;
+        r.Size       = size;
+        r.Iterations = samples.size();
+        if (!samples.empty()) {
+            size_t n = samples.size();
+            double total = 0.0;
+            for (double s : samples) total += s;
+            std::sort(samples.begin(), samples.end());
+            r.MeanUs      = total / n;
+            r.MinUs       = samples.front();
+            r.MaxUs       = samples.back();
+            r.P50Us       = samples[(size_t)(0.50 * (n - 1))];
+            r.P95Us       = samples[(size_t)(0.95 * (n - 1))];
+            r.P99Us       = samples[(size_t)(0.99 * (n - 1))];
+            r.AllocsPerOp = (double)allocs / n;
+        }
+        return r;
+    }
+
+    void Report(const Result& r)
+    {
+        std::printf("%-28s %6d %7llu  mean %11.2f us  p50 %11.2f  p95 %11.2f  p99 %11.2f",
+                    r.Name.c_str(), r.Size, (unsigned long long)r.Iterations,
+                    r.MeanUs, r.P50Us, r.P95Us, r.P99Us);
+        if (r.AllocsPerOp >= 0.0) std::printf("  allocs %9.1f", r.AllocsPerOp);
+        for (const auto& kv : r.Values) std::printf("  %s=%g", kv.first.c_str(), kv.second);
+        if (r.Failed) std::printf("  FAILED");
+        std::printf("\n");
+        std::fflush(stdout);
+        s_Results.push_back(r);
+    }
+
+    static std::vector<int> ParseSizes(const std::string& list)
+    {
+        std::vector<int> sizes;
+        std::stringstream ss(list);
+        std::string item;
+        while (std::getline(ss, item, ','))
+            if (int n = std::atoi(item.c_str())) sizes.push_back(n);
+        std::sort(sizes.begin(), sizes.end());
+        return sizes;
+    }
+
+    static bool WriteJson(const std::string& path)
+    {
+        json results = json::array();
+        for (const Result& r : s_Results) {
+            json values = json::object();
+            for (const auto& kv : r.Values) values[kv.first] = kv.second;
+            results.push_back({
+                { "name", r.Name }, { "size", r.Size }, { "iterations", r.Iterations },
+                { "mean_us", r.MeanUs }, { "min_us", r.MinUs }, { "p50_us", r.P50Us },
+                { "p95_us", r.P95Us }, { "p99_us", r.P99Us }, { "max_us", r.MaxUs }, { "allocs_per_op", r.AllocsPerOp },
+                { "values", values }, { "failed", r.Failed },
+            });
+        }
+        json doc = {
+            { "schema", 1 },
+            { "label", s_Options.Label },
+            { "quick", s_Options.Quick },
+            { "sizes", s_Options.Sizes },
+            { "results", results },
+        };
+        std::ofstream f(path, std::ios::trunc);
+        f << doc.dump(2) << "\n";
+        return f.good();
+    }
+
+    static void Usage(const char* program)
+    {
+        std::printf("usage: %s [--sizes 1000,5000,20000] [--filter name] [--quick]\n"
+                    "       [--json results.json] [--label text] [--list]\n", program);
+        for (const ExtraOption& o : ExtraOptions()) std::printf("  --%s  %s\n", o.Name, o.Help);
+    }
+
+    static ExtraOption* FindExtraOption(const std::string& arg)
+    {
+        for (ExtraOption& o : ExtraOptions())
+            if (arg == std::string("--") + o.Name) return &o;
+        return nullptr;
+    }
+
+    int Run(int argc, char** argv)
+    {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() { return i + 1 < argc ? std::string(argv[++i]) : std::string(); };
+            if      (arg == "--sizes")  s_Options.Sizes    = ParseSizes(value());
+            else if (arg == "--filter") s_Options.Filter   = value();
+            else if (arg == "--json")   s_Options.JsonPath = value();
+            else if (arg == "--label")  s_Options.Label    = value();
+            else if (arg == "--quick")  s_Options.Quick    = true;
+            else if (ExtraOption* o = FindExtraOption(arg)) *o->Value = value();
+            else if (arg == "--list") {
+                for (const Entry& e : Registry()) std::printf("%s\n", e.Name);
+                return 0;
+            } else {
+                Usage(argv[0]);
+                return 2;
+            }
+        }
+
+        auto selected = [](const Entry& e) {
+            return s_Options.Filter.empty() || std::string(e.Name).find(s_Options.Filter) != std::string::npos;
+        };
+
+        bool anySized = std::any_of(Registry().begin(), Registry().end(),
+                                    [&](const Entry& e) { return e.Sized && selected(e); });
+        for (int size : anySized ? s_Options.Sizes : std::vector<int>()) {
+            Corpus corpus(size);
+            for (const Entry& e : Registry())
+                if (e.Sized && selected(e)) e.Fn(corpus);
+        }
+        Corpus empty(0);
+        for (const Entry& e : Registry())
+            if (!e.Sized && selected(e)) e.Fn(empty);
+
+        bool failed = std::any_of(s_Results.begin(), s_Results.end(), [](const Result& r) { return r.Failed; });
+        if (!s_Options.JsonPath.empty() && !WriteJson(s_Options.JsonPath)) {
+            std::fprintf(stderr, "could not write %s\n", s_Options.JsonPath.c_str());
+            return 1;
+        }
+        return failed ? 1 : 0;
+    }
+}
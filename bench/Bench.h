@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Corpus;
+
+// Minimal benchmark harness: benchmarks register themselves with BENCHMARK, the
+// runner calls every sized one once per corpus size (ascending) and the rest
+// once, and every Report ends up in the JSON results file.
+namespace Bench {
+
+    struct Options {
+        std::vector<int> Sizes = { 1000, 5000, 20000 };
+        std::string      Filter;     // substring of benchmark names to run
+        std::string      JsonPath;   // results file; none when empty
+        std::string      Label;      // free-form run label, e.g. the commit id
+        bool             Quick = false;
+    };
+    const Options& GetOptions();
+    // Scales an iteration count down for --quick runs.
+    int Iterations(int full);
+
+    struct Result {
+        std::string Name;
+        int         Size       = 0;    // corpus achievements; 0 if size independent
+        uint64_t    Iterations = 0;
+        double      MeanUs = 0.0, MinUs = 0.0, P50Us = 0.0, P95Us = 0.0, P99Us = 0.0, MaxUs = 0.0;
+        double      AllocsPerOp = -1.0;  // -1: not measured
+        std::vector<std::pair<std::string, double>> Values;  // benchmark specific
+        bool        Failed = false;
+
+        Result& Set(const std::string& key, double value)
+        {
+            Values.emplace_back(key, value);
+            return *this;
+        }
+    };
+
+    // Times `fn` `iterations` times after one untimed warm-up call and counts the
+    // heap allocations it makes.
+    Result Measure(const std::string& name, int size, int iterations,
+                   const std::function<void()>& fn, bool warmup = true);
+    // Builds a result from samples timed by the caller; `allocs` is their total.
+    Result Summarize(const std::string& name, int size, std::vector<double> samplesUs, uint64_t allocs);
+    void Report(const Result& result);
+
+    // Global operator new calls so far.
+    uint64_t Allocations();
+    // Resident memory of this process in bytes; 0 where it cannot be read.
+    size_t ResidentBytes();
+
+    // Adds a "--name value" option to this executable's command line; call before
+    // Run, e.g. from a static Registrar-style object.
+    void AddOption(const char* name, std::string* value, const char* help);
+
+    using BenchFn = void (*)(const Corpus& corpus);
+    struct Registrar {
+        Registrar(const char* name, BenchFn fn, bool sized);
+    };
+
+    int Run(int argc, char** argv);
+}
+
+#define BENCHMARK_IMPL(fn, sized)                                      \
+    static void fn(const Corpus& corpus);                              \
+    static Bench::Registrar fn##_registrar(#fn, fn, sized);            \
+    static void fn([[maybe_unused]] const Corpus& corpus)
+
+// Runs once per corpus size with that corpus.
+#define BENCHMARK(fn)       BENCHMARK_IMPL(fn, true)
+// Runs once; the corpus argument is empty.
+#define BENCHMARK_ONCE(fn)  BENCHMARK_IMPL(fn, false)
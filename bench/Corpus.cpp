@@ -0,0 +1,328 @@
+#include "Corpus.h"
+#include <algorithm>
+#include <cstdio>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+    // splitmix64; unlike <random> distributions its output is the same everywhere
+    struct Rng {
+        uint64_t State;
+        explicit Rng(uint64_t seed) : State(seed * 0x9E3779B97F4A7C15ull + 0x632BE59BD9B4E019ull) {}
+        uint64_t Next()
+        {
+            uint64_t z = (State += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+        int  Range(int lo, int hi) { return lo + (int)(Next() % (uint64_t)(hi - lo + 1)); }
+        bool Chance(int percent)   { return (int)(Next() % 100) < percent; }
+        template <size_t N>
+        const char* Pick(const char* const (&list)[N]) { return list[Next() % N]; }
+    };
+
+    const char* const WORDS[] = {
+        "Ascended", "Legendary", "Dragon", "Mistborn", "Sylvari", "Charr", "Asura", "Norn",
+        "Tyria", "Elona", "Cantha", "Maguuma", "Jormag", "Kralkatorrik", "Aurene", "Primordus",
+        "Mordremoth", "Zhaitan", "Soo-Won", "Balthazar", "Joko", "Kryta", "Ascalon", "Orr",
+        "Bloodstone", "Jade", "Crystal", "Obsidian", "Sanctum", "Fractal", "Raid", "Strike",
+        "Collector", "Explorer", "Hunter", "Slayer", "Master", "Champion", "Hero", "Legend",
+        "Weapon", "Armor", "Trinket", "Backpiece", "Mount", "Skyscale", "Griffon", "Raptor",
+        "Springer", "Skimmer", "Jackal", "Beetle", "Warclaw", "Mastery", "Insight", "Vista",
+        "Jumping", "Puzzle", "Festival", "Wintersday", "Halloween", "Dragonbash", "Lunar", "Zephyr",
+        "Wizard", "Vault", "Astral", "Requiem", "Aetherblade", "Inquest", "Nightmare", "Court",
+        "Scarlet", "Pact", "Vigil", "Priory", "Order", "Whispers", "Lion", "Guard",
+        "Shiverpeaks", "Desert", "Highlands", "Thunderhead", "Bitterfrost", "Drizzlewood", "Seitung", "Echovald",
+        "Dragonfall", "Domain", "Istan", "Sandswept", "Kourna", "Vabbi", "Amnoon", "Crystal Oasis",
+        "Gift", "Mystic", "Clover", "Ectoplasm", "Shard", "Essence", "Luck", "Memory",
+        "Chapter", "Episode", "Journey", "Return", "Path", "Reward", "Track", "Tribute",
+    };
+    const char* const ROMAN[] = { "I", "II", "III", "IV", "V" };
+    const char* const DESCRIPTIONS[] = {
+        "Complete the %s collection.",
+        "Defeat %s champions across Tyria.",
+        "Earn the %s title.",
+        "Find every hidden %s in the region.",
+        "Gather the materials needed to craft %s.",
+        "Help the %s in their time of need.",
+        "Master the %s challenge without being downed.",
+        "Participate in %s events.",
+        "Reach the top of the %s jumping puzzle.",
+        "Unlock all %s skins.",
+        "Explore the %s and discover its secrets.",
+        "Collect %s memories from fallen foes.",
+        "",
+        "",
+    };
+    const char* const REQUIREMENTS[] = {
+        "Collect all %s items.",
+        "Complete %s events in the map.",
+        "Defeat the %s boss.",
+        "Earn points in %s.",
+        "Reach the required mastery level in %s.",
+        "",
+        "",
+        "",
+    };
+    const char* const BIT_TEXTS[] = {
+        "Complete the %s story step.",
+        "Speak with the %s.",
+        "Find the %s cache.",
+        "Defeat %s.",
+        "Visit the %s overlook.",
+        "Attune the %s.",
+    };
+    const char* const FLAGS[] = {
+        "Pvp", "CategoryDisplay", "MoveToTop", "IgnoreNearlyComplete", "Repeatable", "Hidden",
+        "RequiresUnlock", "RepairOnLogin", "Daily", "Weekly", "Monthly", "Permanent",
+    };
+    const char* const ITEM_TYPES[]  = { "Trophy", "Weapon", "Armor", "Trinket", "Consumable", "CraftingMaterial" };
+    const char* const RARITIES[]    = { "Basic", "Fine", "Masterwork", "Rare", "Exotic", "Ascended", "Legendary" };
+
+    std::string Fill(const char* pattern, const char* word)
+    {
+        std::string out = pattern;
+        size_t pos = out.find("%s");
+        if (pos != std::string::npos) out.replace(pos, 2, word);
+        return out;
+    }
+
+    std::string IconUrl(Rng& rng)
+    {
+        static const char HEX[] = "0123456789ABCDEF";
+        std::string url = "https://render.guildwars2.com/file/";
+        for (int i = 0; i < 40; ++i) url += HEX[rng.Next() % 16];
+        url += "/" + std::to_string(rng.Range(60000, 3200000)) + ".png";
+        return url;
+    }
+
+    struct Bit {
+        const char* Type;
+        int         Id = 0;
+        std::string Text;
+    };
+
+    struct Record {
+        json             Json;
+        std::vector<Bit> Bits;
+        int              Goal = 1;   // tier count needed to finish
+    };
+
+    // itemBits > 0 forces an item collection of exactly that many item bits
+    Record Generate(int id, int itemBits)
+    {
+        Rng rng((uint64_t)id);
+        Record rec;
+        int kind = itemBits > 0 ? 99 : rng.Range(0, 99);
+        bool itemSet = kind >= 60;
+
+        std::string name;
+        int words = rng.Range(2, 4);
+        for (int w = 0; w < words; ++w) {
+            if (w) name += ' ';
+            name += rng.Pick(WORDS);
+        }
+        if (rng.Chance(20)) { name += ' '; name += rng.Pick(ROMAN); }
+
+        int bits = 0;
+        if (kind < 60)      bits = rng.Chance(40) ? 0 : rng.Range(1, 5);
+        else if (kind < 92) bits = rng.Range(5, 30);
+        else                bits = rng.Range(50, 120);
+        if (itemBits > 0)   bits = itemBits;
+
+        for (int b = 0; b < bits; ++b) {
+            Bit bit;
+            if (!itemSet) {
+                bit.Type = "Text";
+                bit.Text = Fill(rng.Pick(BIT_TEXTS), rng.Pick(WORDS));
+            } else {
+                int roll = itemBits > 0 ? 0 : rng.Range(0, 99);
+                bit.Type = roll < 80 ? "Item" : roll < 92 ? "Skin" : "Minipet";
+                bit.Id   = roll < 80 ? 20000 + (int)(rng.Next() % 80000) : rng.Range(1, 9000);
+            }
+            rec.Bits.push_back(std::move(bit));
+        }
+
+        json j;
+        j["id"]          = id;
+        j["name"]        = name;
+        j["description"] = Fill(rng.Pick(DESCRIPTIONS), rng.Pick(WORDS));
+        j["requirement"] = Fill(rng.Pick(REQUIREMENTS), rng.Pick(WORDS));
+        j["locked_text"] = rng.Chance(10) ? Fill("Unlocked by %s.", rng.Pick(WORDS)) : "";
+        j["type"]        = itemSet ? "ItemSet" : "Default";
+        if (rng.Chance(30)) j["icon"] = IconUrl(rng);
+
+        json flags = json::array();
+        for (const char* f : FLAGS)
+            if (rng.Chance(8)) flags.push_back(f);
+        j["flags"] = std::move(flags);
+
+        int tiers = rng.Range(1, 5);
+        rec.Goal = bits > 0 ? bits : rng.Range(1, 50) * tiers;
+        json tierList = json::array();
+        for (int t = 1; t <= tiers; ++t)
+            tierList.push_back({ { "count", std::max(1, rec.Goal * t / tiers) }, { "points", rng.Range(1, 10) } });
+        j["tiers"] = std::move(tierList);
+
+        if (bits > 0) {
+            json bitList = json::array();
+            for (const Bit& bit : rec.Bits) {
+                json b = { { "type", bit.Type } };
+                if (bit.Id)            b["id"]   = bit.Id;
+                if (!bit.Text.empty()) b["text"] = bit.Text;
+                bitList.push_back(std::move(b));
+            }
+            j["bits"] = std::move(bitList);
+        }
+        rec.Json = std::move(j);
+        return rec;
+    }
+
+    template <typename Fn>
+    std::string JoinArray(const std::vector<int>& ids, Fn&& record)
+    {
+        std::string body = "[";
+        for (int id : ids) {
+            std::string r = record(id);
+            if (r.empty()) continue;
+            if (body.size() > 1) body += ',';
+            body += r;
+        }
+        body += ']';
+        return body;
+    }
+}
+
+Corpus::Corpus(int size, int itemBits, int firstId) : m_ItemBits(itemBits)
+{
+    m_Ids.reserve(size);
+    for (int i = 0; i < size; ++i) m_Ids.push_back(firstId + i);
+
+    for (int id : m_Ids)
+        for (int item : ItemsOf(id)) m_ItemIds.push_back(item);
+    std::sort(m_ItemIds.begin(), m_ItemIds.end());
+    m_ItemIds.erase(std::unique(m_ItemIds.begin(), m_ItemIds.end()), m_ItemIds.end());
+
+    if (m_Ids.empty()) return;
+    // Whole names, leading words, word prefixes and a couple that match nothing
+    Rng rng(0xC0FFEE);
+    for (int i = 0; i < 12; ++i) {
+        std::string name = Generate(m_Ids[rng.Next() % m_Ids.size()], m_ItemBits).Json["name"];
+        m_Queries.push_back(name);
+        m_Queries.push_back(name.substr(0, name.find(' ')));
+    }
+    for (int i = 0; i < 12; ++i) m_Queries.push_back(std::string(rng.Pick(WORDS)).substr(0, 3));
+    for (int i = 0; i < 8; ++i)  m_Queries.push_back(std::string(rng.Pick(WORDS)) + " " + rng.Pick(WORDS));
+    m_Queries.push_back("zzqx");
+    m_Queries.push_back("mistborn vaultx");
+}
+
+std::string Corpus::CategoriesBody() const
+{
+    json out = json::array();
+    for (size_t first = 0; first < m_Ids.size(); first += CATEGORY_SIZE) {
+        int  index = (int)(first / CATEGORY_SIZE);
+        json cat;
+        cat["id"]           = index + 1;
+        cat["name"]         = "Category " + std::to_string(index + 1);
+        cat["description"]  = "";
+        cat["order"]        = index;
+        cat["icon"]         = "https://render.guildwars2.com/file/CAT/" + std::to_string(index + 1) + ".png";
+        cat["achievements"] = std::vector<int>(m_Ids.begin() + first,
+                                               m_Ids.begin() + std::min(first + CATEGORY_SIZE, m_Ids.size()));
+        out.push_back(std::move(cat));
+    }
+    return out.dump();
+}
+
+std::string Corpus::GroupsBody() const
+{
+    int  categories = (Size() + CATEGORY_SIZE - 1) / CATEGORY_SIZE;
+    json out = json::array();
+    for (int first = 0; first < categories; first += 8) {
+        json group;
+        char guid[40];
+        std::snprintf(guid, sizeof(guid), "00000000-0000-0000-0000-%012d", first / 8 + 1);
+        group["id"]          = guid;
+        group["name"]        = "Group " + std::to_string(first / 8 + 1);
+        group["description"] = "";
+        group["order"]       = first / 8;
+        group["categories"]  = json::array();
+        for (int c = first; c < std::min(first + 8, categories); ++c) group["categories"].push_back(c + 1);
+        out.push_back(std::move(group));
+    }
+    return out.dump();
+}
+
+std::string Corpus::AchievementJson(int id) const
+{
+    return Generate(id, m_ItemBits).Json.dump();
+}
+
+std::string Corpus::ItemJson(int id)
+{
+    Rng rng((uint64_t)id ^ 0x17E45ull);
+    json j;
+    j["id"]          = id;
+    j["name"]        = std::string(rng.Pick(WORDS)) + " " + rng.Pick(WORDS);
+    j["description"] = Fill("Used to craft %s gear.", rng.Pick(WORDS));
+    j["type"]        = rng.Pick(ITEM_TYPES);
+    j["rarity"]      = rng.Pick(RARITIES);
+    j["icon"]        = IconUrl(rng);
+    j["chat_link"]   = "[&AgE" + std::to_string(id) + "AAA=]";
+    return j.dump();
+}
+
+std::vector<int> Corpus::ItemsOf(int id) const
+{
+    std::vector<int> items;
+    for (const Bit& bit : Generate(id, m_ItemBits).Bits)
+        if (bit.Id && bit.Type[0] == 'I') items.push_back(bit.Id);
+    return items;
+}
+
+std::string Corpus::AchievementsBody(const std::vector<int>& ids) const
+{
+    return JoinArray(ids, [&](int id) {
+        return std::binary_search(m_Ids.begin(), m_Ids.end(), id) ? AchievementJson(id) : std::string();
+    });
+}
+
+std::string Corpus::ItemsBody(const std::vector<int>& ids) const
+{
+    return JoinArray(ids, [&](int id) {
+        return std::binary_search(m_ItemIds.begin(), m_ItemIds.end(), id) ? ItemJson(id) : std::string();
+    });
+}
+
+std::string Corpus::ProgressBody(const std::vector<int>& ids, int round) const
+{
+    return JoinArray(ids, [&](int id) -> std::string {
+        if (!std::binary_search(m_Ids.begin(), m_Ids.end(), id)) return {};
+        Rng rng((uint64_t)id * 7 + 1);
+        if (!rng.Chance(75)) return {};
+
+        Record rec = Generate(id, m_ItemBits);
+        int current = rng.Range(0, rec.Goal);
+        // Each round moves roughly one in ten entries forward
+        for (int r = 1; r <= round; ++r)
+            if (Rng((uint64_t)id * 131 + r).Chance(10)) current = std::min(rec.Goal, current + 1);
+
+        json j = { { "id", id }, { "current", current }, { "max", rec.Goal }, { "done", current >= rec.Goal } };
+        if (!rec.Bits.empty()) {
+            json bits = json::array();
+            for (int b = 0; b < current && b < (int)rec.Bits.size(); ++b) bits.push_back(b);
+            j["bits"] = std::move(bits);
+        }
+        return j.dump();
+    });
+}
+
+std::string Corpus::IdsBody() const
+{
+    json ids = m_Ids;
+    return ids.dump();
+}
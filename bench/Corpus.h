@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Deterministic synthetic API data. Every record is derived from its id alone
+// through a fixed PRNG, so the corpus of N achievements is a prefix of any
+// larger one and identical on every platform and run.
+//
+// The mix follows the live catalog: most achievements have no or a few text
+// bits, about a third are item collections of 5-30 bits and a few are large
+// collections of up to 120 bits. Descriptions and bit texts repeat across
+// records the way tiers and daily variants do in the real data. A corpus made
+// with `itemBits` instead holds nothing but item collections of that many bits.
+// Ids run from `firstId` on, so corpora can be made disjoint.
+class Corpus {
+public:
+    explicit Corpus(int size, int itemBits = 0, int firstId = 1);
+
+    int                     Size()           const { return (int)m_Ids.size(); }
+    const std::vector<int>& AchievementIds() const { return m_Ids; }
+    // Item ids referenced by any bit, sorted and unique.
+    const std::vector<int>& ItemIds()        const { return m_ItemIds; }
+    // Multi-word queries built from the vocabulary, a mix of hits and near misses.
+    const std::vector<std::string>& Queries() const { return m_Queries; }
+
+    // Response bodies in the API's format; unknown ids are left out like the API does.
+    std::string AchievementsBody(const std::vector<int>& ids) const;
+    std::string ItemsBody(const std::vector<int>& ids) const;
+    // Account progress for the ids that have any; `round` advances some of them.
+    std::string ProgressBody(const std::vector<int>& ids, int round) const;
+    std::string IdsBody() const;
+    // ?ids=all bodies: the corpus in categories of CATEGORY_SIZE consecutive ids,
+    // eight categories to a group. Category ids count from 1 in id order.
+    std::string CategoriesBody() const;
+    std::string GroupsBody() const;
+    static constexpr int CATEGORY_SIZE = 40;
+
+    std::string        AchievementJson(int id) const;
+    static std::string ItemJson(int id);
+    // Item ids the achievement's bits point at, in bit order.
+    std::vector<int>   ItemsOf(int id) const;
+
+private:
+    int                      m_ItemBits = 0;
+    std::vector<int>         m_Ids;
+    std::vector<int>         m_ItemIds;
+    std::vector<std::string> m_Queries;
+};
@@ -0,0 +1,589 @@
+#include "ApiJson.h"
+#include "AchievementCache.h"
+#include "Bench.h"
+#include "Corpus.h"
+#include "FakeHost.h"
+#include "GW2Api.h"
+#include "IconCache.h"
+#include "IconPipeline.h"
+#include "NameSearch.h"
+#include "RefreshScheduler.h"
+#include "SearchService.h"
+#include "SnapshotStore.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+// Benchmarks of the data layer, run against a FakeHost. Sized benchmarks run in
+// the order they are registered; the ones that need the catalog, items or the
+// cache file set them up themselves, so any --filter works on its own.
+
+static const std::string API_KEY = "bench";
+
+static double Seconds(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+// The whole corpus as one /v2/achievements response, and its parse
+static const std::string& CatalogBody(const Corpus& corpus)
+{
+    static int         s_Size = -1;
+    static std::string s_Body;
+    if (s_Size != corpus.Size()) {
+        s_Body = corpus.AchievementsBody(corpus.AchievementIds());
+        s_Size = corpus.Size();
+    }
+    return s_Body;
+}
+
+static const std::vector<Achievement>& CatalogRecords(const Corpus& corpus)
+{
+    static int                      s_Size = -1;
+    static std::vector<Achievement> s_Records;
+    if (s_Size != corpus.Size()) {
+        s_Records.clear();
+        ApiJson::ParseAchievements(CatalogBody(corpus), s_Records);
+        s_Size = corpus.Size();
+    }
+    return s_Records;
+}
+
+static void SyncCatalog(int maxInFlight)
+{
+    GW2Api::FetchAllAchievementsAsync(maxInFlight);
+    while (GW2Api::IsLoadingAllAchievements())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+// A sync ends by prefetching items in the background; it must not outlive the corpus it is served from
+static void WaitForItemPrefetch()
+{
+    while (GW2Api::IsPrefetchingItems())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+// Corpora grow in prefixes, so the catalog is current once it holds as many entries
+static void EnsureCatalog(const Corpus& corpus)
+{
+    if (GW2Api::CachedAchievementCount() >= corpus.Size()) return;
+    FakeHost::Serve(corpus);
+    SyncCatalog(8);
+    WaitForItemPrefetch();
+}
+
+static void EnsureItems(const Corpus& corpus)
+{
+    const std::vector<int>& ids = corpus.ItemIds();
+    if (GW2Api::AcquireSnapshot().Items->Items.size() >= ids.size()) return;
+    FakeHost::Serve(corpus);
+    for (size_t first = 0; first < ids.size(); first += 200)
+        GW2Api::FetchItems(RequestLane_Background, std::vector<int>(ids.begin() + first, ids.begin() + std::min(first + 200, ids.size())));
+}
+
+static std::string CachePath()
+{
+    return FakeHost::Directory() + "achievements_cache.bin";
+}
+
+BENCHMARK(parse_achievements)
+{
+    const std::string& body = CatalogBody(corpus);
+    double mb = (double)body.size() / 1e6;
+    int    n  = corpus.Size();
+
+    auto sax = Bench::Measure("parse_achievements/sax", n, Bench::Iterations(20), [&]() {
+        std::vector<Achievement> out;
+        ApiJson::ParseAchievements(body, out);
+    });
+    sax.Set("mb_per_s", mb / (sax.MeanUs / 1e6)).Set("allocs_per_record", sax.AllocsPerOp / n);
+    Bench::Report(sax);
+
+    // The DOM parse alone; a lower bound for the reader the streaming one replaced
+    auto dom = Bench::Measure("parse_achievements/dom", n, Bench::Iterations(20), [&]() {
+        json doc = json::parse(body);
+    });
+    dom.Set("mb_per_s", mb / (dom.MeanUs / 1e6)).Set("allocs_per_record", dom.AllocsPerOp / n);
+    Bench::Report(dom);
+}
+
+// Taken by category_browse, the first benchmark to grow the store at each size
+static GW2Api::CatalogMemory s_MemoryBeforeGrowth;
+static size_t                s_ResidentBeforeGrowth = 0;
+
+// Registered before anything fills the store. Corpora grow in prefixes, so the
+// last category of each size holds achievements no smaller size had.
+BENCHMARK(category_browse)
+{
+    s_MemoryBeforeGrowth   = GW2Api::CatalogMemoryUsage();
+    s_ResidentBeforeGrowth = Bench::ResidentBytes();
+    constexpr int LATENCY_MS = 100;
+    FakeHost::CorpusTransport& transport = FakeHost::Serve(corpus, LATENCY_MS);
+    auto start = std::chrono::steady_clock::now();
+    GW2Api::FetchCategoryTreeAsync();
+    while (GW2Api::IsLoadingCategoryTree())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    double treeSeconds = Seconds(start);
+    uint64_t treeRequests = transport.Stats().Requests;
+
+    auto tree = GW2Api::GetCategoryTree();
+    int  catId = (corpus.Size() + Corpus::CATEGORY_SIZE - 1) / Corpus::CATEGORY_SIZE;
+    const AchievementCategory* cat = tree ? tree->FindCategory(catId) : nullptr;
+    Bench::Result r = Bench::Summarize("category_browse/tree", corpus.Size(), { treeSeconds * 1e6 }, 0);
+    r.Set("groups", tree ? (double)tree->Groups.size() : 0.0)
+     .Set("categories", tree ? (double)tree->Categories.size() : 0.0)
+     .Set("requests", (double)treeRequests).Set("latency_ms", LATENCY_MS);
+    r.Failed = !cat;
+    Bench::Report(r);
+    if (!cat) return;
+
+    // Opening the category: its achievements, as the tree lists them
+    start = std::chrono::steady_clock::now();
+    GW2Api::LoadCategoryAsync(catId);
+    while (GW2Api::IsCategoryLoading(catId))
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    double categorySeconds = Seconds(start);
+    WaitForItemPrefetch();
+
+    GW2Api::Snapshot snap = GW2Api::AcquireSnapshot();
+    Bench::Result c = Bench::Summarize("category_browse/open_category", corpus.Size(), { categorySeconds * 1e6 }, 0);
+    c.Set("achievements", (double)cat->achievements.size())
+     .Set("requests", (double)(transport.Stats().Requests - treeRequests))
+     .Set("tree_plus_category_ms", (treeSeconds + categorySeconds) * 1000.0);
+    for (int id : cat->achievements) c.Failed |= snap.FindAchievement(id) == nullptr;
+    Bench::Report(c);
+    FakeHost::Serve(corpus);
+}
+
+// Registered ahead of everything else that syncs, so each size's sync leaves
+// the items of its new achievements to the prefetch that follows it
+BENCHMARK(item_prefetch)
+{
+    FakeHost::CorpusTransport& transport = FakeHost::Serve(corpus, 10);
+    size_t before = GW2Api::AcquireSnapshot().Items->Items.size();
+    SyncCatalog(8);
+    uint64_t requests = transport.Stats().Requests;
+    auto start = std::chrono::steady_clock::now();
+    WaitForItemPrefetch();
+    double seconds = Seconds(start);
+
+    GW2Api::Snapshot snap = GW2Api::AcquireSnapshot();
+    size_t fetched = snap.Items->Items.size() - before;
+    Bench::Result r = Bench::Summarize("item_prefetch/after_sync", corpus.Size(), { seconds * 1e6 }, 0);
+    r.Set("items", (double)fetched).Set("requests", (double)(transport.Stats().Requests - requests))
+     .Set("items_per_s", seconds > 0.0 ? fetched / seconds : 0.0);
+    // Nothing fetched means some earlier benchmark already had the items
+    r.Failed = fetched == 0 && !corpus.ItemIds().empty();
+    for (int id : corpus.ItemIds()) r.Failed |= snap.FindItem(id) == nullptr;
+    Bench::Report(r);
+
+    // With nothing missing, what is left is the scan over every achievement's bits
+    FakeHost::Serve(corpus);
+    Bench::Report(Bench::Measure("item_prefetch/nothing_missing", corpus.Size(), Bench::Iterations(10), []() {
+        GW2Api::PrefetchItemsAsync();
+        WaitForItemPrefetch();
+    }));
+}
+
+// Registered after the benchmarks that grow the store from the previous size's
+// prefix. What the catalog grew by is held against the resident memory added
+// meanwhile, which also counts items, indexes and the syncs' own buffers.
+BENCHMARK(catalog_memory)
+{
+    EnsureCatalog(corpus);
+    size_t resident = Bench::ResidentBytes();
+
+    // The first call after the table changed counts; the rest are cache hits
+    auto start = std::chrono::steady_clock::now();
+    GW2Api::CatalogMemory mem = GW2Api::CatalogMemoryUsage();
+    double firstUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    auto r = Bench::Measure("catalog_memory/usage", corpus.Size(), Bench::Iterations(1000), []() {
+        GW2Api::CatalogMemoryUsage();
+    });
+    double estimated = (double)(mem.Entries + mem.Strings) -
+                       (double)(s_MemoryBeforeGrowth.Entries + s_MemoryBeforeGrowth.Strings);
+    r.Set("first_call_us", firstUs)
+     .Set("estimated_bytes", estimated)
+     .Set("resident_bytes", (double)resident - (double)s_ResidentBeforeGrowth);
+    Bench::Report(r);
+}
+
+BENCHMARK(catalog_sync)
+{
+    // Every batch pays a round trip, so in-flight requests are what a sync scales with.
+    // Only a new connection pays the handshake; the rest reuse a kept-alive one.
+    constexpr int HANDSHAKE_MS = 30;
+    for (int inFlight : { 1, 4, 8 }) {
+        FakeHost::CorpusTransport& transport = FakeHost::Serve(corpus, 10, HANDSHAKE_MS);
+        auto r = Bench::Measure("catalog_sync/inflight_" + std::to_string(inFlight), corpus.Size(),
+                                Bench::Iterations(3), [&]() { SyncCatalog(inFlight); }, false);
+        CatalogSync::Stats stats = GW2Api::LastCatalogSyncStats();
+        HttpTransportStats net = transport.Stats();
+        r.Set("batches", stats.Batches).Set("failed_batches", stats.FailedBatches)
+         .Set("batches_per_s", stats.BatchesPerSec).Set("sync_s", stats.WallSeconds)
+         .Set("conns_opened", (double)net.ConnectionsOpened).Set("conns_reused", (double)net.ConnectionsReused)
+         .Set("handshake_ms_saved", (double)net.ConnectionsReused * HANDSHAKE_MS);
+        r.Failed = stats.FailedBatches != 0 || stats.Achievements != corpus.Size();
+        Bench::Report(r);
+        WaitForItemPrefetch();
+    }
+    FakeHost::Serve(corpus);
+}
+
+BENCHMARK(name_scan)
+{
+    std::vector<std::pair<int, std::string>> names;
+    for (const Achievement& ach : CatalogRecords(corpus)) names.emplace_back(ach.id, ach.name);
+    NameSearch::Index index(names);
+
+    std::vector<std::string> folded;
+    for (const std::string& q : corpus.Queries()) {
+        folded.emplace_back();
+        NameSearch::Fold(q, folded.back());
+    }
+
+    size_t hits = 0;
+    auto indexed = Bench::Measure("name_scan/index", corpus.Size(), Bench::Iterations(50), [&]() {
+        for (const std::string& q : folded) hits += index.Find(q, index.Size()).size();
+    });
+    Bench::Report(indexed.Set("queries", (double)folded.size()));
+
+    // What every keystroke did before the index: fold each name, then search it
+    size_t naiveHits = 0;
+    std::string name;
+    auto naive = Bench::Measure("name_scan/naive", corpus.Size(), Bench::Iterations(10), [&]() {
+        for (const std::string& q : folded)
+            for (const auto& entry : names) {
+                name.clear();
+                NameSearch::Fold(entry.second, name);
+                if (name.find(q) != std::string::npos) ++naiveHits;
+            }
+    });
+    naive.Failed = hits / (size_t)(Bench::Iterations(50) + 1) != naiveHits / (size_t)(Bench::Iterations(10) + 1);
+    Bench::Report(naive.Set("queries", (double)folded.size()));
+}
+
+BENCHMARK(search)
+{
+    EnsureCatalog(corpus);
+    const std::vector<std::string>& queries = corpus.Queries();
+
+    auto ranked = Bench::Measure("search/ranked", corpus.Size(), Bench::Iterations(20), [&]() {
+        for (const std::string& q : queries) GW2Api::SearchAchievements(q, 50);
+    });
+    Bench::Report(ranked.Set("queries", (double)queries.size()));
+
+    // Typing a whole name one character at a time: every keystroke from scratch,
+    // then narrowing the previous keystroke's matches whenever the search
+    // service would
+    const std::string& typed = queries.front();
+    auto scratch = Bench::Measure("search/keystrokes_full", corpus.Size(), Bench::Iterations(10), [&]() {
+        for (size_t len = 1; len <= typed.size(); ++len) GW2Api::SearchAchievements(typed.substr(0, len), 50);
+    });
+    Bench::Report(scratch.Set("keystrokes", (double)typed.size()));
+
+    size_t narrowedKeystrokes = 0;
+    auto narrowed = Bench::Measure("search/keystrokes_narrowed", corpus.Size(), Bench::Iterations(10), [&]() {
+        std::vector<int> previous, matched;
+        std::string previousFolded, folded;
+        narrowedKeystrokes = 0;
+        for (size_t len = 1; len <= typed.size(); ++len) {
+            std::string query = typed.substr(0, len);
+            NameSearch::Fold(query, folded);
+            bool narrow = SearchService::CanNarrow(previousFolded, previous.size(), folded);
+            narrowedKeystrokes += narrow;
+            GW2Api::SearchRequest req;
+            req.Within  = narrow ? &previous : nullptr;
+            req.Matched = &matched;
+            matched.clear();
+            GW2Api::SearchAchievements(query, 50, req);
+            previous.swap(matched);
+            previousFolded.swap(folded);
+        }
+    });
+    Bench::Report(narrowed.Set("keystrokes", (double)typed.size())
+                          .Set("narrowed", (double)narrowedKeystrokes));
+}
+
+BENCHMARK(lookup)
+{
+    EnsureCatalog(corpus);
+    EnsureItems(corpus);
+    const std::vector<int>& ids = corpus.AchievementIds();
+
+    size_t found = 0;
+    auto snapshot = Bench::Measure("lookup/snapshot_achievements", corpus.Size(), Bench::Iterations(50), [&]() {
+        GW2Api::Snapshot snap = GW2Api::AcquireSnapshot();
+        for (int id : ids) found += snap.FindAchievement(id) != nullptr;
+    });
+    snapshot.Set("ns_per_lookup", snapshot.MeanUs * 1000.0 / ids.size());
+    snapshot.Failed = found % ids.size() != 0;
+    Bench::Report(snapshot);
+
+    const std::vector<int>& items = corpus.ItemIds();
+    size_t foundItems = 0;
+    auto getItem = Bench::Measure("lookup/get_item", corpus.Size(), Bench::Iterations(50), [&]() {
+        for (int id : items) foundItems += GW2Api::GetItem(id) != nullptr;
+    });
+    getItem.Set("ns_per_lookup", items.empty() ? 0.0 : getItem.MeanUs * 1000.0 / items.size());
+    getItem.Failed = !items.empty() && foundItems % items.size() != 0;
+    Bench::Report(getItem);
+}
+
+BENCHMARK(cache_save)
+{
+    EnsureCatalog(corpus);
+    auto r = Bench::Measure("cache_save", corpus.Size(), Bench::Iterations(10), []() {
+        GW2Api::SaveAchievementCache();
+    });
+    std::error_code ec;
+    GW2Api::CatalogMemory mem = GW2Api::CatalogMemoryUsage();
+    r.Set("file_bytes", (double)std::filesystem::file_size(CachePath(), ec))
+     .Set("entry_bytes", (double)mem.Entries).Set("string_bytes", (double)mem.Strings);
+    Bench::Report(r);
+}
+
+BENCHMARK(cache_load)
+{
+    EnsureCatalog(corpus);
+    if (!std::filesystem::exists(CachePath())) GW2Api::SaveAchievementCache();
+
+    // The JSON cache earlier versions wrote; it is only read while no binary one exists
+    const std::string legacy = FakeHost::Directory() + "achievements_cache.json";
+    const std::string parked = CachePath() + ".parked";
+    AchievementCache::WriteFile(legacy, "{\"build\":1,\"achievements\":" +
+                                        corpus.AchievementsBody(corpus.AchievementIds()) + "}");
+    std::error_code ec;
+    std::filesystem::rename(CachePath(), parked, ec);
+    // The catalog is already loaded, so the merge keeps the live entries; what is
+    // measured is reading every record and indexing the text
+    auto fromJson = Bench::Measure("cache_load/json", corpus.Size(), Bench::Iterations(10), []() {
+        GW2Api::LoadAchievementCache();
+    });
+    std::filesystem::rename(parked, CachePath(), ec);
+    fromJson.Set("file_bytes", (double)std::filesystem::file_size(legacy, ec));
+    std::filesystem::remove(legacy, ec);
+    Bench::Report(fromJson);
+
+    auto binary = Bench::Measure("cache_load/binary", corpus.Size(), Bench::Iterations(10), []() {
+        GW2Api::LoadAchievementCache();
+    });
+    binary.Set("file_bytes", (double)std::filesystem::file_size(CachePath(), ec));
+    Bench::Report(binary.Set("cached", GW2Api::CachedAchievementCount()));
+}
+
+BENCHMARK(cache_decode)
+{
+    EnsureCatalog(corpus);
+    GW2Api::SaveAchievementCache();
+    AchievementCache::Reader reader;
+    if (!reader.Open(CachePath())) {
+        Bench::Result r;
+        r.Name   = "cache_decode";
+        r.Size   = corpus.Size();
+        r.Failed = true;
+        Bench::Report(r);
+        return;
+    }
+    const std::vector<int>& ids = corpus.AchievementIds();
+    double n = (double)ids.size();
+
+    // What startup decodes, what opening an entry decodes, and the zero-copy view search uses
+    auto summary = Bench::Measure("cache_decode/summary", corpus.Size(), Bench::Iterations(20), [&]() {
+        for (int id : ids) {
+            Achievement ach;
+            reader.ReadSummary(id, ach);
+        }
+    });
+    Bench::Report(summary.Set("ns_per_record", summary.MeanUs * 1000.0 / n));
+
+    auto details = Bench::Measure("cache_decode/details", corpus.Size(), Bench::Iterations(20), [&]() {
+        for (int id : ids) {
+            Achievement ach;
+            reader.ReadDetails(id, ach);
+        }
+    });
+    Bench::Report(details.Set("ns_per_record", details.MeanUs * 1000.0 / n));
+
+    AchievementCache::DetailsView view;
+    auto views = Bench::Measure("cache_decode/view", corpus.Size(), Bench::Iterations(20), [&]() {
+        for (int id : ids) reader.ReadDetails(id, view);
+    });
+    Bench::Report(views.Set("ns_per_record", views.MeanUs * 1000.0 / n));
+}
+
+BENCHMARK(progress_diff)
+{
+    EnsureCatalog(corpus);
+    FakeHost::CorpusTransport& transport = FakeHost::Serve(corpus);
+    const std::vector<int>& ids = corpus.AchievementIds();
+
+    // The first fetch sets the baseline; each timed one sees a later round
+    GW2Api::FetchTrackedProgress(API_KEY, ids);
+    GW2Api::TakeProgressEvents();
+    size_t events = 0;
+    auto r = Bench::Measure("progress_diff", corpus.Size(), Bench::Iterations(10), [&]() {
+        ++transport.ProgressRound;
+        GW2Api::FetchTrackedProgress(API_KEY, ids);
+        events += GW2Api::TakeProgressEvents().size();
+    }, false);
+    r.Set("events_per_fetch", (double)events / (double)r.Iterations);
+    r.Failed = !GW2Api::ProgressSyncStatus().LastChanged;
+    Bench::Report(r);
+}
+
+struct StressCell {
+    uint64_t Value = 0;
+};
+
+BENCHMARK_ONCE(snapshot_stress)
+{
+    // One writer republishes every cell with a new value while readers check that
+    // each version they load is internally consistent and never goes back in time
+    constexpr int CELLS   = 256;
+    constexpr int READERS = 4;
+    const double  seconds = Bench::GetOptions().Quick ? 0.2 : 1.0;
+
+    SnapshotTable<StressCell> table;
+    table.Update([&](auto& items) {
+        for (int i = 0; i < CELLS; ++i) items[i] = std::make_shared<const StressCell>();
+    });
+
+    std::atomic<bool>     stop{false};
+    std::atomic<uint64_t> reads{0}, writes{0}, violations{0};
+    auto r = Bench::Measure("snapshot_stress", 0, 1, [&]() {
+        std::vector<std::thread> threads;
+        threads.emplace_back([&]() {
+            for (uint64_t value = 1; !stop; ++value) {
+                table.Update([&](auto& items) {
+                    for (auto& kv : items) kv.second = std::make_shared<const StressCell>(StressCell{ value });
+                });
+                ++writes;
+            }
+        });
+        for (int i = 0; i < READERS; ++i)
+            threads.emplace_back([&]() {
+                uint64_t last = 0, count = 0;
+                while (!stop) {
+                    auto version = table.Load();
+                    uint64_t value = version->Find(0)->Value;
+                    if (value < last) ++violations;
+                    for (const auto& kv : version->Items)
+                        if (kv.second->Value != value) { ++violations; break; }
+                    last = value;
+                    ++count;
+                }
+                reads += count;
+            });
+        auto start = std::chrono::steady_clock::now();
+        while (Seconds(start) < seconds) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        stop = true;
+        for (auto& t : threads) t.join();
+    }, false);
+    r.Set("reads_per_s", (double)reads / seconds).Set("writes_per_s", (double)writes / seconds)
+     .Set("violations", (double)violations);
+    r.Failed = violations != 0 || writes == 0;
+    Bench::Report(r);
+}
+
+BENCHMARK_ONCE(refresh_scheduler)
+{
+    // One simulated hour at 60 frames a second: a map change every ten minutes,
+    // moving in two-minute stretches, alt-tabbed out for the last ten minutes, and
+    // every fourth poll finding something new
+    RefreshScheduler::Stats stats;
+    auto r = Bench::Measure("refresh_scheduler/hour", 0, Bench::Iterations(10), [&]() {
+        RefreshScheduler scheduler(RefreshScheduler::Config{}, 1234);
+        uint64_t polls = 0;
+        for (int frame = 0; frame < 3600 * 60; ++frame) {
+            RefreshScheduler::Signals s;
+            s.Now     = frame / 60.0;
+            s.InGame  = true;
+            s.MapId   = 1000 + (uint32_t)(s.Now / 600.0);
+            s.UiState = s.Now < 3000.0 ? RefreshScheduler::UiState_GameHasFocus : 0;
+            s.Moving  = ((int)(s.Now / 120.0) % 2) == 0;
+            if (scheduler.Tick(s)) scheduler.OnResult(++polls % 4 == 0);
+        }
+        stats = scheduler.GetStats();
+    });
+    r.Set("requests", (double)stats.Requests).Set("legacy_requests", (double)stats.LegacyRequests)
+     .Set("saved_per_hour", stats.SavedPerHour());
+    r.Failed = stats.Requests == 0 || stats.Requests > stats.LegacyRequests;
+    Bench::Report(r);
+}
+
+BENCHMARK_ONCE(icon_pipeline)
+{
+    // Scrolls through pages of icons that are each on screen until loaded: the first
+    // pass downloads (5 ms per request, 15 ms more on a new connection), the second
+    // finds them all on disk
+    constexpr int PAGES = 10, PER_PAGE = 40, HANDSHAKE_MS = 15;
+    std::string dir = FakeHost::Directory() + "icons/";
+    std::filesystem::create_directories(dir);
+    IconCache::Open(dir, 64ull << 20);
+    FakeHost::CorpusTransport& transport = FakeHost::Serve(corpus, 5, HANDSHAKE_MS);
+
+    for (const char* pass : { "icon_pipeline/download", "icon_pipeline/disk" }) {
+        HttpTransportStats netBefore = transport.Stats();
+        IconPipeline::Start(4, GW2Api::LoadIcon);
+        double firstIcon = 0.0;
+        int page = 0;
+        auto r = Bench::Measure(pass, 0, PAGES, [&]() {
+            size_t target = IconPipeline::GetStats().Loaded + PER_PAGE;
+            while (IconPipeline::GetStats().Loaded < target) {
+                IconPipeline::BeginFrame();
+                for (int i = 0; i < PER_PAGE; ++i) {
+                    std::string n = std::to_string(page * PER_PAGE + i);
+                    IconPipeline::Request("https://render.guildwars2.com/file/BENCH/" + n + ".png", "ICON_BENCH_" + n);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            firstIcon += IconPipeline::GetStats().FirstIconMs;
+            ++page;
+        }, false);
+        IconPipeline::Stats stats = IconPipeline::GetStats();
+        HttpTransportStats net = transport.Stats();
+        uint64_t reused = net.ConnectionsReused - netBefore.ConnectionsReused;
+        r.Set("first_icon_ms", firstIcon / PAGES).Set("avg_latency_ms", stats.AvgLatencyMs)
+         .Set("icons_per_s", PER_PAGE / (r.MeanUs / 1e6))
+         .Set("conns_opened", (double)(net.ConnectionsOpened - netBefore.ConnectionsOpened))
+         .Set("conns_reused", (double)reused).Set("handshake_ms_saved", (double)reused * HANDSHAKE_MS);
+        Bench::Report(r);
+        IconPipeline::Stop();
+    }
+
+    // Every other icon fails to load: only the rest may count as loaded
+    IconPipeline::Stats before = IconPipeline::GetStats();
+    IconPipeline::Start(4, [](const std::string&, const std::string& texName) {
+        return texName.back() % 2 == 0;
+    });
+    IconPipeline::BeginFrame();
+    for (int i = 0; i < PER_PAGE; ++i)
+        IconPipeline::Request("https://render.guildwars2.com/file/BENCH/fail.png", "ICON_FAIL_" + std::to_string(i));
+    size_t loaded = 0, failed = 0;
+    while (loaded + failed < (size_t)PER_PAGE) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        IconPipeline::Stats now = IconPipeline::GetStats();
+        loaded = now.Loaded - before.Loaded;
+        failed = now.Failed - before.Failed;
+    }
+    IconPipeline::Stop();
+    Bench::Result failures;
+    failures.Name = "icon_pipeline/failures";
+    failures.Set("loaded", (double)loaded).Set("failed", (double)failed);
+    failures.Failed = loaded != PER_PAGE / 2 || failed != PER_PAGE / 2;
+    Bench::Report(failures);
+
+    IconCache::Stats cache = IconCache::GetStats();
+    IconCache::Close();
+    Bench::Result r;
+    r.Name = "icon_pipeline/cache";
+    r.Set("hits", (double)cache.Hits).Set("misses", (double)cache.Misses).Set("files", (double)cache.Files);
+    r.Failed = cache.Hits < (uint64_t)(PAGES * PER_PAGE);
+    Bench::Report(r);
+}
@@ -0,0 +1,161 @@
+#include "FakeHost.h"
+#include "Corpus.h"
+#include "RequestScheduler.h"
+#include "Shared.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace FakeHost {
+
+    static std::string           s_Directory;
+    static AddonAPI_t            s_Api{};
+    static Mumble::LinkedMem     s_Mumble{};
+    static std::atomic<bool>     s_AllTextures{false};
+    static Texture_t             s_Texture{ 32, 32, &s_Texture };
+    static std::atomic<uint64_t> s_ImGuiAllocs{0};
+
+    static const char* GetAddonDirectory(const char*) { return s_Directory.c_str(); }
+    static void        LoadTexture(const char*, const char*, TEXTURES_RECEIVECALLBACK) {}
+
+    static void* GetDataLink(const char* id)
+    {
+        return std::strcmp(id, DL_MUMBLE_LINK) == 0 ? &s_Mumble : nullptr;
+    }
+
+    static Texture_t* GetTexture(const char*)
+    {
+        return s_AllTextures.load(std::memory_order_relaxed) ? &s_Texture : nullptr;
+    }
+
+    static void* ImGuiMalloc(size_t size, void*)
+    {
+        s_ImGuiAllocs.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size);
+    }
+    static void ImGuiFree(void* p, void*) { std::free(p); }
+
+    void Install()
+    {
+        fs::path dir = fs::temp_directory_path() / "AchievementTrackerBench";
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+        fs::create_directories(dir, ec);
+        s_Directory = (dir / "").string();
+
+        s_Mumble.Context.MapId   = 50;
+        s_Mumble.Context.UiState = 1u << 3;   // game has focus
+
+        s_Api.ImguiMalloc             = reinterpret_cast<void*>(ImGuiMalloc);
+        s_Api.ImguiFree               = reinterpret_cast<void*>(ImGuiFree);
+        s_Api.Paths_GetAddonDirectory = GetAddonDirectory;
+        s_Api.DataLink_Get            = GetDataLink;
+        s_Api.Textures_Get            = GetTexture;
+        s_Api.Textures_LoadFromFile   = LoadTexture;
+        APIDefs = &s_Api;
+
+        RequestScheduler::Start();
+    }
+
+    const std::string& Directory() { return s_Directory; }
+
+    Mumble::LinkedMem& MumbleLink() { return s_Mumble; }
+
+    void SetAllTexturesLoaded(bool loaded) { s_AllTextures = loaded; }
+
+    uint64_t ImGuiAllocations() { return s_ImGuiAllocs.load(std::memory_order_relaxed); }
+
+    static std::vector<int> ParseIds(const std::string& path)
+    {
+        std::vector<int> ids;
+        size_t pos = path.find("ids=");
+        if (pos == std::string::npos) return ids;
+        const char* p = path.c_str() + pos + 4;
+        while (*p) {
+            char* end = nullptr;
+            long id = std::strtol(p, &end, 10);
+            if (end == p) break;
+            ids.push_back((int)id);
+            p = *end == ',' ? end + 1 : end;
+        }
+        return ids;
+    }
+
+    int CorpusTransport::Get(const std::string& host, const std::string& path,
+                             const std::string&, HttpResponse& resp)
+    {
+        if (m_LatencyMs < 0) {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            ++m_Stats.Requests;
+            resp.Status = 0;
+            resp.Body.clear();
+            return 0;
+        }
+
+        bool opened;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            Host& h = m_Hosts[host];
+            m_Cv.wait(lock, [&]() { return h.Idle > 0 || h.Open < m_MaxConns; });
+            ++m_Stats.Requests;
+            opened = h.Idle == 0;
+            if (opened) { ++h.Open; ++m_Stats.ConnectionsOpened; }
+            else        { --h.Idle; ++m_Stats.ConnectionsReused; }
+        }
+        int waitMs = m_LatencyMs + (opened ? m_HandshakeMs : 0);
+        if (waitMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+
+        Respond(host, path, resp);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            ++m_Hosts[host].Idle;
+        }
+        m_Cv.notify_all();
+        return resp.Status;
+    }
+
+    void CorpusTransport::Respond(const std::string& host, const std::string& path, HttpResponse& resp)
+    {
+        resp.RetryAfter = 0;
+        resp.Status     = 200;
+        auto startsWith = [&](const char* prefix) { return path.rfind(prefix, 0) == 0; };
+        if (host == Http::RenderHost) {
+            resp.Body.assign(2048, '\x89');   // icon-sized payload
+        } else if (startsWith("/v2/account/achievements?ids=")) {
+            resp.Body = m_Corpus.ProgressBody(ParseIds(path), ProgressRound.load());
+            if (resp.Body == "[]") resp.Status = 404;
+        } else if (path == "/v2/achievements/categories?ids=all") {
+            resp.Body = m_Corpus.CategoriesBody();
+        } else if (path == "/v2/achievements/groups?ids=all") {
+            resp.Body = m_Corpus.GroupsBody();
+        } else if (startsWith("/v2/achievements?ids=")) {
+            resp.Body = m_Corpus.AchievementsBody(ParseIds(path));
+        } else if (path == "/v2/achievements") {
+            resp.Body = m_Corpus.IdsBody();
+        } else if (startsWith("/v2/items?ids=")) {
+            resp.Body = m_Corpus.ItemsBody(ParseIds(path));
+        } else {
+            resp.Status = 404;
+            resp.Body.clear();
+        }
+    }
+
+    HttpTransportStats CorpusTransport::Stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Stats;
+    }
+
+    CorpusTransport& Serve(const Corpus& corpus, int latencyMs, int handshakeMs)
+    {
+        auto transport = std::make_shared<CorpusTransport>(corpus, latencyMs, handshakeMs);
+        Http::SetTransport(transport);
+        return *transport;
+    }
+}
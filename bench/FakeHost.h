@@ -0,0 +1,70 @@
+#pragma once
+#include "HttpTransport.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+
+class Corpus;
+namespace Mumble { struct LinkedMem; }
+
+// Headless stand-ins for everything the addon reaches outside itself: the Nexus
+// API (an addon directory under the system temp dir, a MumbleLink block,
+// textures, the ImGui allocator) and the network (a transport that answers
+// from a Corpus).
+namespace FakeHost {
+
+    // Installs the stub AddonAPI_t and starts the request scheduler without limits;
+    // the addon directory starts empty.
+    void Install();
+    // Addon directory with a trailing separator, as Paths_GetAddonDirectory returns it.
+    const std::string& Directory();
+
+    // What DataLink_Get(DL_MUMBLE_LINK) hands out: in game on map 50, focused.
+    Mumble::LinkedMem& MumbleLink();
+    // Whether Textures_Get reports every identifier as loaded; off by default.
+    void SetAllTexturesLoaded(bool loaded);
+    // Allocations made through the host's ImguiMalloc so far.
+    uint64_t ImGuiAllocations();
+
+    // Models connections the way the WinHTTP transport keeps them: per host, up
+    // to `maxConnectionsPerHost` kept alive and handed to the next request; a new
+    // one costs `handshakeMs` on top of the request's latency.
+    class CorpusTransport : public HttpTransport {
+    public:
+        CorpusTransport(const Corpus& corpus, int latencyMs, int handshakeMs = 0, int maxConnectionsPerHost = 6)
+            : m_Corpus(corpus), m_LatencyMs(latencyMs), m_HandshakeMs(handshakeMs),
+              m_MaxConns(std::max(1, maxConnectionsPerHost)) {}
+
+        using HttpTransport::Get;
+        int Get(const std::string& host, const std::string& path,
+                const std::string& bearerToken, HttpResponse& resp) override;
+        HttpTransportStats Stats() const override;
+
+        // Progress bodies advance with the round, so each one looks like time passed.
+        std::atomic<int> ProgressRound{0};
+
+    private:
+        struct Host {
+            int Open = 0;
+            int Idle = 0;
+        };
+
+        void Respond(const std::string& host, const std::string& path, HttpResponse& resp);
+
+        const Corpus&               m_Corpus;
+        int                         m_LatencyMs;
+        int                         m_HandshakeMs;
+        const int                   m_MaxConns;
+        mutable std::mutex          m_Mutex;
+        std::condition_variable     m_Cv;
+        std::map<std::string, Host> m_Hosts;
+        HttpTransportStats          m_Stats;
+    };
+
+    // Routes Http::GetTransport() to a CorpusTransport over `corpus`. A negative
+    // latency takes the network away: every request fails as if the host were unreachable.
+    CorpusTransport& Serve(const Corpus& corpus, int latencyMs = 0, int handshakeMs = 0);
+}
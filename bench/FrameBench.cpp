@@ -0,0 +1,297 @@
+#include "Bench.h"
+#include "AchievementCache.h"
+#include "ApiJson.h"
+#include "Corpus.h"
+#include "FakeHost.h"
+#include "GW2Api.h"
+#include "RequestScheduler.h"
+#include "Settings.h"
+#include "Shared.h"
+#include "UI.h"
+#include <imgui.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+// Frame cost of UI::Render: a headless ImGui context on a 2560x1440 display,
+// the tracker window expanded over a tracked set served by the FakeHost, every
+// icon loaded. Each tracked set is "NxB": N achievements of B item bits each.
+// Settings are never loaded, so collapse-state saves stay off the disk.
+
+static std::string s_TrackedSets   = "5x30,50x30,200x30,50x300";
+static std::string s_Frames        = "2000";
+static std::string s_StartupSet    = "50x30";
+static std::string s_LatencyMs     = "150";
+
+static struct FrameOptions {
+    FrameOptions()
+    {
+        Bench::AddOption("tracked", &s_TrackedSets, "tracked sets to render, e.g. 5x30,50x300 (achievements x item bits)");
+        Bench::AddOption("frames",  &s_Frames,      "timed frames per tracked set (default 2000)");
+        Bench::AddOption("startup-tracked", &s_StartupSet, "tracked set of the startup benchmark (default 50x30)");
+        Bench::AddOption("latency", &s_LatencyMs,   "simulated API latency per request in ms for startup (default 150)");
+    }
+} s_FrameOptions;
+
+static constexpr int    WARMUP_FRAMES = 60;   // view building, window auto-fit
+static constexpr float  FRAME_SECONDS = 1.0f / 60.0f;
+
+struct TrackedSet {
+    int Achievements = 0;
+    int Bits         = 0;
+};
+
+static std::vector<TrackedSet> ParseTrackedSets(const std::string& list)
+{
+    std::vector<TrackedSet> sets;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        TrackedSet set;
+        if (std::sscanf(item.c_str(), "%dx%d", &set.Achievements, &set.Bits) == 2 && set.Achievements > 0)
+            sets.push_back(set);
+    }
+    return sets;
+}
+
+// Fetches everything the tracker shows through the fake network, as startup would
+static void LoadTrackedSet(const Corpus& corpus)
+{
+    FakeHost::Serve(corpus);
+    const std::vector<int>& ids   = corpus.AchievementIds();
+    const std::vector<int>& items = corpus.ItemIds();
+    for (size_t first = 0; first < ids.size(); first += 200)
+        GW2Api::FetchAchievements(RequestLane_Background, std::vector<int>(ids.begin() + first, ids.begin() + std::min(first + 200, ids.size())));
+    for (size_t first = 0; first < items.size(); first += 200)
+        GW2Api::FetchItems(RequestLane_Background, std::vector<int>(items.begin() + first, items.begin() + std::min(first + 200, items.size())));
+    GW2Api::FetchTrackedProgress("bench", ids);
+    GW2Api::TakeProgressEvents();
+
+    g_Settings.ShowWindow          = true;
+    g_Settings.TrackedAchievements = ids;
+    g_Settings.CollapsedHeaders.clear();
+    g_Settings.CollapsedDetails.clear();
+}
+
+static ImGuiContext* CreateHeadlessContext()
+{
+    ImGui::SetAllocatorFunctions(
+        reinterpret_cast<void*(*)(size_t,void*)>(APIDefs->ImguiMalloc),
+        reinterpret_cast<void(*)(void*,void*)>(APIDefs->ImguiFree));
+    ImGuiContext* ctx = ImGui::CreateContext();
+    APIDefs->ImguiContext = ctx;
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(2560.0f, 1440.0f);
+    io.DeltaTime   = FRAME_SECONDS;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // NewFrame needs a built atlas
+    return ctx;
+}
+
+BENCHMARK_ONCE(frame)
+{
+    int frames = Bench::GetOptions().Quick ? 200 : std::max(1, std::atoi(s_Frames.c_str()));
+    MumbleLink = &FakeHost::MumbleLink();
+    FakeHost::SetAllTexturesLoaded(true);
+
+    for (const TrackedSet& set : ParseTrackedSets(s_TrackedSets)) {
+        Corpus corpus(set.Achievements, set.Bits);
+        LoadTrackedSet(corpus);
+        ImGuiContext* ctx = CreateHeadlessContext();
+
+        std::vector<double> frameUs, renderUs;
+        frameUs.reserve(frames);
+        renderUs.reserve(frames);
+        uint64_t addonAllocs = 0, imguiAllocs = 0;
+        int vertices = 0;
+        for (int f = 0; f < WARMUP_FRAMES + frames; ++f) {
+            uint64_t news    = Bench::Allocations();
+            uint64_t mallocs = FakeHost::ImGuiAllocations();
+            auto t0 = std::chrono::steady_clock::now();
+            ImGui::NewFrame();
+            auto t1 = std::chrono::steady_clock::now();
+            UI::Render();
+            auto t2 = std::chrono::steady_clock::now();
+            ImGui::Render();
+            auto t3 = std::chrono::steady_clock::now();
+            if (f < WARMUP_FRAMES) continue;
+
+            frameUs.push_back(std::chrono::duration<double, std::micro>(t3 - t0).count());
+            renderUs.push_back(std::chrono::duration<double, std::micro>(t2 - t1).count());
+            addonAllocs += Bench::Allocations() - news;
+            imguiAllocs += FakeHost::ImGuiAllocations() - mallocs;
+            vertices = ImGui::GetDrawData()->TotalVtxCount;
+        }
+
+        std::string label = std::to_string(set.Achievements) + "x" + std::to_string(set.Bits);
+        double perFrame = 1.0 / frames;
+        // Whole frame: NewFrame, UI::Render and ImGui's own end of frame; allocations from both heaps
+        Bench::Result whole = Bench::Summarize("frame/" + label, set.Achievements, std::move(frameUs),
+                                               addonAllocs + imguiAllocs);
+        whole.Set("bits", (double)set.Achievements * set.Bits)
+             .Set("addon_allocs_per_frame", addonAllocs * perFrame)
+             .Set("imgui_allocs_per_frame", imguiAllocs * perFrame)
+             .Set("vertices", vertices);
+        Bench::Report(whole);
+        Bench::Report(Bench::Summarize("frame/" + label + "/ui_render", set.Achievements,
+                                       std::move(renderUs), addonAllocs));
+
+        ImGui::DestroyContext(ctx);
+        APIDefs->ImguiContext = nullptr;
+    }
+    g_Settings.Flush();
+}
+
+// Startup: time from load until the first frame that shows every tracked
+// achievement whole (details, item names, progress), as entry.cpp runs it: one
+// thread loading the caches, one revalidating over a network `--latency` ms
+// away. "cold" starts without cache files, "warm" with caches that match the
+// API and "warm_offline" with the same caches and no network at all. Each mode
+// uses its own id range, so nothing it shows is left in memory by another.
+static constexpr int    CATALOG_FILLER   = 5000;    // cached achievements besides the tracked ones
+static constexpr double STARTUP_TIMEOUT  = 30.0;    // seconds
+
+static std::string ProgressCachePath(const std::string& apiKey)
+{
+    uint32_t hash = 2166136261u;  // as GW2Api names it
+    for (unsigned char c : apiKey) hash = (hash ^ c) * 16777619u;
+    char name[32];
+    std::snprintf(name, sizeof(name), "progress_%08x.json", hash);
+    return FakeHost::Directory() + name;
+}
+
+// What the addon would have left on disk after the last session with `tracked`
+static void WriteCaches(const Corpus& tracked, const Corpus& filler, const std::string& apiKey)
+{
+    std::vector<Achievement> records;
+    ApiJson::ParseAchievements(tracked.AchievementsBody(tracked.AchievementIds()), records);
+    ApiJson::ParseAchievements(filler.AchievementsBody(filler.AchievementIds()), records);
+    std::vector<const Achievement*> all;
+    for (const auto& ach : records) all.push_back(&ach);
+    AchievementCache::WriteFile(FakeHost::Directory() + "achievements_cache.bin", AchievementCache::Serialize(0, all));
+    AchievementCache::WriteFile(FakeHost::Directory() + "items_cache.json", tracked.ItemsBody(tracked.ItemIds()));
+    AchievementCache::WriteFile(ProgressCachePath(apiKey), tracked.ProgressBody(tracked.AchievementIds(), 0));
+}
+
+static void RemoveCaches(const std::string& apiKey)
+{
+    std::remove((FakeHost::Directory() + "achievements_cache.bin").c_str());
+    std::remove((FakeHost::Directory() + "items_cache.json").c_str());
+    std::remove(ProgressCachePath(apiKey).c_str());
+}
+
+static bool ShowsWhole(const GW2Api::Snapshot& snap, const Corpus& corpus, const std::vector<int>& withProgress)
+{
+    for (int id : corpus.AchievementIds()) {
+        const Achievement* ach = snap.FindAchievement(id);
+        if (!ach || !ach->details_loaded) return false;
+        for (int item : corpus.ItemsOf(id))
+            if (!snap.FindItem(item)) return false;
+    }
+    for (int id : withProgress)
+        if (!snap.FindProgress(id)) return false;
+    return true;
+}
+
+static uint64_t Generations()
+{
+    GW2Api::Snapshot snap = GW2Api::AcquireSnapshot();
+    return snap.Achievements->Generation + snap.Items->Generation + snap.Progress->Generation;
+}
+
+BENCHMARK_ONCE(startup)
+{
+    std::vector<TrackedSet> sets = ParseTrackedSets(s_StartupSet);
+    TrackedSet set = sets.empty() ? TrackedSet{ 50, 30 } : sets.front();
+    int latency = std::max(0, std::atoi(s_LatencyMs.c_str()));
+    const std::string apiKey = "bench-startup";
+    MumbleLink = &FakeHost::MumbleLink();
+    FakeHost::SetAllTexturesLoaded(true);
+
+    const struct { const char* Name; bool Cached; bool Online; } MODES[] = {
+        { "cold",         false, true  },
+        { "warm",         true,  true  },
+        { "warm_offline", true,  false },
+    };
+    int firstId = 1000000;
+    for (const auto& mode : MODES) {
+        Corpus tracked(set.Achievements, set.Bits, firstId);
+        Corpus filler(CATALOG_FILLER, 0, firstId + 100000);
+        firstId += 1000000;
+
+        std::vector<AccountAchievement> progress;
+        ApiJson::ParseAccountAchievements(tracked.ProgressBody(tracked.AchievementIds(), 0), progress);
+        std::vector<int> withProgress;
+        for (const auto& p : progress) withProgress.push_back(p.id);
+
+        if (mode.Cached) WriteCaches(tracked, filler, apiKey);
+        else             RemoveCaches(apiKey);
+        FakeHost::Serve(tracked, mode.Online ? latency : -1);
+        g_Settings.ShowWindow          = true;
+        g_Settings.TrackedAchievements = tracked.AchievementIds();
+        g_Settings.ApiKey              = apiKey;
+        ImGuiContext* ctx = CreateHeadlessContext();
+
+        std::atomic<bool>     cacheDone{false}, revalidated{false};
+        std::atomic<uint64_t> cachedGenerations{0};
+        auto start = std::chrono::steady_clock::now();
+        std::thread cacheThread([&]() {
+            GW2Api::LoadCaches(tracked.AchievementIds(), apiKey);
+            cachedGenerations = Generations();
+            cacheDone = true;
+        });
+        std::thread initThread([&]() {
+            GW2Api::RevalidateTracked(tracked.AchievementIds(), apiKey);
+            revalidated = true;
+        });
+
+        // Render until the tracker shows everything and, online, revalidation is over
+        double completeMs = -1.0;
+        int frames = 0, completeFrame = 0;
+        for (;;) {
+            bool whole = ShowsWhole(GW2Api::AcquireSnapshot(), tracked, withProgress);
+            ImGui::NewFrame();
+            UI::Render();
+            ImGui::Render();
+            ++frames;
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (whole && completeMs < 0.0) {
+                completeMs    = elapsed * 1000.0;
+                completeFrame = frames;
+            }
+            bool settled = cacheDone && (revalidated || !mode.Online);
+            if ((completeMs >= 0.0 && settled) || elapsed > STARTUP_TIMEOUT) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // Offline, revalidation is still backing off; stopping the scheduler fails it fast
+        RequestScheduler::Stop();
+        cacheThread.join();
+        initThread.join();
+        RequestScheduler::Start();
+
+        Bench::Result r;
+        r.Name   = std::string("startup/") + mode.Name;
+        r.Size   = set.Achievements;
+        r.Failed = completeMs < 0.0;
+        r.Set("first_complete_ms", completeMs)
+         .Set("first_complete_frame", completeFrame)
+         .Set("latency_ms", mode.Online ? latency : -1)
+         // Table swaps after the caches were in; 0 means revalidation found nothing new
+         .Set("revalidate_swaps", mode.Online ? (double)(Generations() - cachedGenerations) : 0.0);
+        Bench::Report(r);
+
+        ImGui::DestroyContext(ctx);
+        APIDefs->ImguiContext = nullptr;
+        GW2Api::TakeProgressEvents();
+    }
+    RemoveCaches(apiKey);
+    g_Settings.ApiKey.clear();
+    g_Settings.Flush();
+}
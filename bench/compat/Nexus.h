@@ -0,0 +1,29 @@
+#pragma once
+#include <windows.h>
+
+// Stand-in for the Nexus API header in the non-Windows benchmark build. It keeps
+// the member names the addon uses so the host stub can fill them in, and only
+// those members.
+struct Texture_t {
+    unsigned Width;
+    unsigned Height;
+    void*    Resource;
+};
+
+typedef void (*GUI_RENDER)();
+typedef void (*TEXTURES_RECEIVECALLBACK)(const char* aIdentifier, Texture_t* aTexture);
+
+#define DL_MUMBLE_LINK          "DL_MUMBLE_LINK"
+#define DL_MUMBLE_LINK_IDENTITY "DL_MUMBLE_LINK_IDENTITY"
+
+struct AddonAPI_t {
+    void* ImguiContext;
+    void* ImguiMalloc;
+    void* ImguiFree;
+
+    const char* (*Paths_GetAddonDirectory)(const char* aName);
+    void*       (*DataLink_Get)(const char* aIdentifier);
+    Texture_t*  (*Textures_Get)(const char* aIdentifier);
+    void        (*Textures_LoadFromFile)(const char* aIdentifier, const char* aFilename,
+                                         TEXTURES_RECEIVECALLBACK aCallback);
+};
@@ -0,0 +1,3 @@
+#pragma once
+// ShellExecuteA lives in the compat <windows.h>.
+#include <windows.h>
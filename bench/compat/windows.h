@@ -0,0 +1,35 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+// Just enough of <windows.h> for the addon's portable sources and UI.cpp to
+// compile in the non-Windows benchmark build.
+typedef void* HMODULE;
+typedef unsigned long DWORD;
+
+#define SW_SHOWNORMAL 1
+#define _TRUNCATE     ((size_t)-1)
+
+inline DWORD GetTickCount()
+{
+    return (DWORD)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Opening links does nothing headless.
+inline void* ShellExecuteA(void*, const char*, const char*, const char*, const char*, int)
+{
+    return nullptr;
+}
+
+// Only the _TRUNCATE form the addon uses.
+inline int strncpy_s(char* dst, size_t dstSize, const char* src, size_t)
+{
+    if (!dst || dstSize == 0) return 1;
+    size_t n = std::strlen(src);
+    if (n >= dstSize) n = dstSize - 1;
+    std::memcpy(dst, src, n);
+    dst[n] = '\0';
+    return 0;
+}
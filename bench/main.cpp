@@ -0,0 +1,8 @@
+#include "Bench.h"
+#include "FakeHost.h"
+
+int main(int argc, char** argv)
+{
+    FakeHost::Install();
+    return Bench::Run(argc, argv);
+}
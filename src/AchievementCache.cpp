@@ -0,0 +1,244 @@
+#include "AchievementCache.h"
+#include "GW2Api.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace AchievementCache {
+
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t INDEX_ENTRY = 8;
+
+    static void PutU32(std::string& out, uint32_t v)
+    {
+        char b[4];
+        std::memcpy(b, &v, 4);
+        out.append(b, 4);
+    }
+
+    static void PutStr(std::string& out, std::string_view s)
+    {
+        PutU32(out, (uint32_t)s.size());
+        out.append(s);
+    }
+
+    // Bounds-checked reader over one record; any overrun flips `Ok` and yields zeros.
+    struct Cursor {
+        const char* Pos;
+        const char* End;
+        bool        Ok = true;
+
+        uint32_t U32()
+        {
+            uint32_t v = 0;
+            if (End - Pos < 4) { Ok = false; return 0; }
+            std::memcpy(&v, Pos, 4);
+            Pos += 4;
+            return v;
+        }
+
+        std::string_view Str()
+        {
+            uint32_t len = U32();
+            if (!Ok || (size_t)(End - Pos) < len) { Ok = false; return {}; }
+            std::string_view v(Pos, len);
+            Pos += len;
+            return v;
+        }
+    };
+
+    std::string Serialize(uint32_t buildId, const std::vector<const Achievement*>& achievements)
+    {
+        std::vector<const Achievement*> sorted(achievements);
+        std::sort(sorted.begin(), sorted.end(),
+            [](const Achievement* a, const Achievement* b) { return a->id < b->id; });
+
+        std::string records;
+        std::string index;
+        size_t recordsBase = HEADER_SIZE + sorted.size() * INDEX_ENTRY;
+        for (const Achievement* a : sorted) {
+            PutU32(index, (uint32_t)a->id);
+            PutU32(index, (uint32_t)(recordsBase + records.size()));
+
+            PutStr(records, a->name);
+            PutStr(records, a->icon);
+            PutU32(records, (uint32_t)a->type);
+            PutU32(records, a->flags);
+
+            PutStr(records, a->description);
+            PutStr(records, a->requirement);
+            PutStr(records, a->locked_text);
+            PutU32(records, (uint32_t)a->bits.size());
+            for (const auto& b : a->bits) {
+                PutU32(records, (uint32_t)b.type);
+                PutU32(records, (uint32_t)b.id);
+                PutStr(records, b.text);
+            }
+            PutU32(records, (uint32_t)a->tiers.size());
+            for (const auto& t : a->tiers) {
+                PutU32(records, (uint32_t)t.count);
+                PutU32(records, (uint32_t)t.points);
+            }
+        }
+
+        std::string out;
+        out.reserve(recordsBase + records.size());
+        PutU32(out, Magic);
+        PutU32(out, Version);
+        PutU32(out, buildId);
+        PutU32(out, (uint32_t)sorted.size());
+        out += index;
+        out += records;
+        return out;
+    }
+
+    bool WriteFile(const std::string& path, const std::string& data)
+    {
+        std::string tmp = path + ".tmp";
+        bool written;
+        {
+            std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+            f.write(data.data(), (std::streamsize)data.size());
+            written = f.good();
+        }
+        std::error_code ec;
+        if (written) {
+            std::filesystem::rename(tmp, path, ec);
+            if (!ec) return true;
+        }
+        // Never leave a partial file behind
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+
+    bool Reader::Open(const std::string& path)
+    {
+        Close();
+        if (!m_File.Open(path)) return false;
+
+        Cursor c{ m_File.Data(), m_File.Data() + m_File.Size() };
+        uint32_t magic   = c.U32();
+        uint32_t version = c.U32();
+        uint32_t build   = c.U32();
+        uint32_t count   = c.U32();
+        if (!c.Ok || magic != Magic || version != Version ||
+            (m_File.Size() - HEADER_SIZE) / INDEX_ENTRY < count)
+        {
+            m_File.Close();
+            return false;
+        }
+
+        m_Index   = m_File.Data() + HEADER_SIZE;
+        m_BuildId = build;
+        m_Count   = count;
+        return true;
+    }
+
+    void Reader::Close()
+    {
+        m_File.Close();
+        m_Index   = nullptr;
+        m_BuildId = 0;
+        m_Count   = 0;
+    }
+
+    int Reader::IdAt(size_t index) const
+    {
+        int32_t id = 0;
+        if (index < m_Count) std::memcpy(&id, m_Index + index * INDEX_ENTRY, 4);
+        return id;
+    }
+
+    const char* Reader::Record(int id) const
+    {
+        size_t lo = 0, hi = m_Count;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            int midId = IdAt(mid);
+            if (midId < id) lo = mid + 1;
+            else            hi = mid;
+        }
+        if (lo >= m_Count || IdAt(lo) != id) return nullptr;
+
+        uint32_t offset = 0;
+        std::memcpy(&offset, m_Index + lo * INDEX_ENTRY + 4, 4);
+        if (offset >= m_File.Size()) return nullptr;
+        return m_File.Data() + offset;
+    }
+
+    std::string_view Reader::Name(int id) const
+    {
+        const char* rec = Record(id);
+        if (!rec) return {};
+        Cursor c{ rec, m_File.Data() + m_File.Size() };
+        return c.Str();
+    }
+
+    static void SkipSummary(Cursor& c)
+    {
+        c.Str(); c.Str(); c.U32(); c.U32();
+    }
+
+    bool Reader::ReadSummary(int id, Achievement& out) const
+    {
+        const char* rec = Record(id);
+        if (!rec) return false;
+        Cursor c{ rec, m_File.Data() + m_File.Size() };
+        out.id   = id;
+        out.name  = std::string(c.Str());
+        out.icon  = PooledString(c.Str());
+        uint32_t type = c.U32();
+        out.type  = type <= AchievementType_ItemSet ? (AchievementType)type : AchievementType_Default;
+        out.flags = c.U32();
+        return c.Ok;
+    }
+
+    bool Reader::ReadDetails(int id, DetailsView& out) const
+    {
+        const char* rec = Record(id);
+        if (!rec) return false;
+        Cursor c{ rec, m_File.Data() + m_File.Size() };
+        SkipSummary(c);
+        out.Description = c.Str();
+        out.Requirement = c.Str();
+        out.LockedText  = c.Str();
+        uint32_t bits = c.U32();
+        out.Bits.clear();
+        out.Bits.reserve(std::min<uint32_t>(bits, 4096));
+        for (uint32_t i = 0; i < bits && c.Ok; ++i) {
+            uint32_t type = c.U32();
+            int      bid  = (int)c.U32();
+            out.Bits.push_back({ type < BitType_Unknown ? (BitType)type : BitType_Unknown, bid, c.Str() });
+        }
+        uint32_t tiers = c.U32();
+        out.Tiers.clear();
+        for (uint32_t i = 0; i < tiers && i < 64 && c.Ok; ++i) {
+            int count  = (int)c.U32();
+            int points = (int)c.U32();
+            out.Tiers.push_back({ count, points });
+        }
+        return c.Ok;
+    }
+
+    bool Reader::ReadDetails(int id, Achievement& out) const
+    {
+        DetailsView view;
+        if (!ReadDetails(id, view)) return false;
+        out.description = PooledString(view.Description);
+        out.requirement = PooledString(view.Requirement);
+        out.locked_text = PooledString(view.LockedText);
+        out.bits.clear();
+        out.bits.reserve(view.Bits.size());
+        for (const auto& b : view.Bits) {
+            AchievementBit bit;
+            bit.type = b.Type;
+            bit.id   = b.Id;
+            bit.text = PooledString(b.Text);
+            out.bits.push_back(bit);
+        }
+        out.tiers.clear();
+        for (const auto& t : view.Tiers) out.tiers.push_back({ t.Count, t.Points });
+        return true;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct Achievement;
+enum BitType : uint8_t;
+
+// Versioned binary achievement cache, memory-mapped at load:
+//
+//   Header  { Magic, Version, BuildId, Count }
+//   Index   { Id, Offset } x Count, sorted by id
+//   Records
+//
+// A record starts with what listing and search need (name, icon, type, flags)
+// and is followed by description, requirement, locked text, bits and tiers, which are
+// only decoded when an achievement is actually displayed. Strings are a u32
+// length followed by the bytes; enums and flag sets are stored as u32; all
+// integers are little-endian.
+namespace AchievementCache {
+
+    constexpr uint32_t Magic   = 0x43484341; // "ACHC"
+    constexpr uint32_t Version = 3;
+
+    std::string Serialize(uint32_t buildId, const std::vector<const Achievement*>& achievements);
+
+    // Writes to a temp file next to `path` and renames it over the old cache.
+    bool WriteFile(const std::string& path, const std::string& data);
+
+    // Zero-copy view of a record's details, valid while the Reader stays open.
+    struct DetailsView {
+        struct Bit {
+            BitType          Type;
+            int              Id;
+            std::string_view Text;
+        };
+        struct Tier {
+            int Count;
+            int Points;
+        };
+        std::string_view  Description;
+        std::string_view  Requirement;
+        std::string_view  LockedText;
+        std::vector<Bit>  Bits;
+        std::vector<Tier> Tiers;
+    };
+
+    class Reader {
+    public:
+        bool Open(const std::string& path);
+        void Close();
+
+        bool     IsOpen()  const { return m_Index != nullptr; }
+        uint32_t BuildId() const { return m_BuildId; }
+        size_t   Count()   const { return m_Count; }
+        int      IdAt(size_t index) const;
+
+        // Zero-copy view of a name straight out of the mapping; empty if unknown.
+        std::string_view Name(int id) const;
+
+        // Fills id, name, icon, type and flags. Detail fields are left untouched.
+        bool ReadSummary(int id, Achievement& out) const;
+        // Fills description, requirement, locked_text, bits and tiers.
+        bool ReadDetails(int id, Achievement& out) const;
+        // Same, without copying anything out of the mapping.
+        bool ReadDetails(int id, DetailsView& out) const;
+
+    private:
+        const char* Record(int id) const;
+
+        MappedFile  m_File;
+        const char* m_Index   = nullptr;
+        uint32_t    m_BuildId = 0;
+        uint32_t    m_Count   = 0;
+    };
+}
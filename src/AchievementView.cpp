@@ -0,0 +1,85 @@
+#include "AchievementView.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace AchievementView {
+
+    static std::unordered_map<int, View> s_Views;
+
+    static void Build(const GW2Api::Snapshot& snap, int id, View& v)
+    {
+        v.Id             = id;
+        v.Ach            = snap.Achievements->FindShared(id);
+        v.Progress       = snap.Progress->FindShared(id);
+        v.AchievementGen = snap.Achievements->Generation;
+        v.ItemGen        = snap.Items->Generation;
+        v.ProgressGen    = snap.Progress->Generation;
+
+        v.HeaderLabel  = v.Ach ? v.Ach->name : "Achievement #" + std::to_string(id);
+        v.HeaderLabel += "##ach" + std::to_string(id);
+
+        v.ProgressText.clear();
+        if (v.Progress && v.Progress->max > 0)
+            v.ProgressText = std::to_string(v.Progress->current) + "/" + std::to_string(v.Progress->max);
+
+        // Textures found by the previous build stay valid across rebuilds
+        std::vector<Bit> old;
+        old.swap(v.Bits);
+        v.Mode = Layout_List;
+        if (v.Ach && v.Ach->details_loaded) {
+            v.Bits.reserve(v.Ach->bits.size());
+            for (size_t i = 0; i < v.Ach->bits.size(); ++i) {
+                const AchievementBit& src = v.Ach->bits[i];
+                Bit b;
+                b.Type = src.type;
+                b.Id   = src.id;
+                b.Text = src.text;
+                if (src.type != BitType_Text) v.Mode = Layout_Grid;
+                if (src.type == BitType_Item) {
+                    b.ItemInfo = snap.Items->FindShared(src.id);
+                    b.TexName  = "ITEM_ICON_" + std::to_string(src.id);
+                    b.Label    = b.ItemInfo ? b.ItemInfo->name : "ID " + std::to_string(src.id);
+                    if (i < old.size() && old[i].Id == src.id) b.Tex = old[i].Tex;
+                }
+                v.Bits.push_back(std::move(b));
+            }
+        }
+
+        v.Done.assign((v.Bits.size() + 63) / 64, 0);
+        if (v.Progress)
+            for (int bit : v.Progress->bits)
+                if (bit >= 0 && (size_t)bit < v.Bits.size())
+                    v.Done[bit >> 6] |= 1ull << (bit & 63);
+    }
+
+    View& Get(const GW2Api::Snapshot& snap, int id)
+    {
+        auto ins = s_Views.try_emplace(id);
+        View& v = ins.first->second;
+        if (!ins.second && v.ProgressGen != snap.Progress->Generation &&
+            snap.Progress->FindShared(id) == v.Progress)
+        {
+            // Progress updates keep unchanged entries, so other rows' changes skip this one
+            v.ProgressGen = snap.Progress->Generation;
+        }
+        if (ins.second ||
+            v.AchievementGen != snap.Achievements->Generation ||
+            v.ItemGen        != snap.Items->Generation ||
+            v.ProgressGen    != snap.Progress->Generation)
+        {
+            Build(snap, id, v);
+        }
+        return v;
+    }
+
+    void Prune(const std::vector<int>& tracked)
+    {
+        if (s_Views.size() <= tracked.size()) return;
+        for (auto it = s_Views.begin(); it != s_Views.end(); ) {
+            if (std::find(tracked.begin(), tracked.end(), it->first) == tracked.end())
+                it = s_Views.erase(it);
+            else
+                ++it;
+        }
+    }
+}
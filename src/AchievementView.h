@@ -0,0 +1,55 @@
+#pragma once
+#include "GW2Api.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Per-achievement render data for the tracker window: everything the frame loop
+// needs that depends only on the achievement, its items and the account's
+// progress. Rebuilt when one of those tables publishes a new generation, so
+// steady-state frames just read it.
+namespace AchievementView {
+
+    enum Layout : uint8_t {
+        Layout_List,   // every bit is plain text
+        Layout_Grid,   // icons and text in an 8-column table
+    };
+
+    struct Bit {
+        BitType                     Type = BitType_Text;
+        int                         Id   = 0;
+        PooledString                Text;
+        std::shared_ptr<const Item> ItemInfo;  // null until the item is fetched
+        std::string                 TexName;   // icon texture identifier for item bits
+        std::string                 Label;     // fallback when the icon isn't loaded
+        void*                       Tex = nullptr;  // resolved lazily, kept once found
+    };
+
+    struct View {
+        int Id = 0;
+        std::shared_ptr<const Achievement>        Ach;
+        std::shared_ptr<const AccountAchievement> Progress;
+
+        std::string HeaderLabel;
+        std::string ProgressText;   // "current/max", empty without progress
+        Layout      Mode = Layout_List;
+        std::vector<Bit>      Bits;
+        std::vector<uint64_t> Done;  // bitset over Bits
+
+        bool IsDone(size_t bit) const
+        {
+            return (bit >> 6) < Done.size() && (Done[bit >> 6] >> (bit & 63)) & 1;
+        }
+
+        uint64_t AchievementGen = 0;
+        uint64_t ItemGen        = 0;
+        uint64_t ProgressGen    = 0;
+    };
+
+    // View of `id` as of `snap`, rebuilt if the snapshot moved on since.
+    View& Get(const GW2Api::Snapshot& snap, int id);
+
+    // Drops views of achievements no longer in `tracked`.
+    void Prune(const std::vector<int>& tracked);
+}
@@ -0,0 +1,439 @@
+#include "ApiJson.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include <cstring>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace ApiJson {
+
+    // Tracks nesting depth and turns every scalar into one of three calls. Depths
+    // count open containers: the records of a root array sit at depth 2.
+    class Reader : public nlohmann::json_sax<json> {
+    public:
+        bool null() override                           { return true; }
+        bool boolean(bool v) override                  { OnInt(v ? 1 : 0); return true; }
+        bool number_integer(number_integer_t v) override   { OnInt(v); return true; }
+        bool number_unsigned(number_unsigned_t v) override { OnInt((int64_t)v); return true; }
+        bool number_float(number_float_t v, const string_t&) override { OnInt((int64_t)v); return true; }
+        bool string(string_t& v) override              { OnString(v); return true; }
+        bool binary(binary_t&) override                { return true; }
+        bool key(string_t& k) override                 { OnKey(k); return true; }
+
+        bool start_object(std::size_t) override { ++m_Depth; OnOpen(false); return true; }
+        bool end_object() override              { OnClose(false); --m_Depth; return true; }
+        bool start_array(std::size_t) override  { ++m_Depth; m_RootArray |= m_Depth == 1; OnOpen(true); return true; }
+        bool end_array() override               { OnClose(true); --m_Depth; return true; }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override
+        {
+            return false;
+        }
+
+        // Whether the body had the expected shape; lists must have an array at the
+        // root, so an error object never passes for an empty result.
+        virtual bool Complete() const { return m_RootArray; }
+
+    protected:
+        virtual void OnOpen(bool /*array*/) {}
+        virtual void OnClose(bool /*array*/) {}
+        virtual void OnKey(const std::string& /*key*/) {}
+        virtual void OnInt(int64_t /*v*/) {}
+        virtual void OnString(std::string& /*v*/) {}
+
+        int  m_Depth     = 0;
+        bool m_RootArray = false;
+    };
+
+    static bool Run(std::string_view body, Reader& reader)
+    {
+        return json::sax_parse(body.begin(), body.end(), &reader) && reader.Complete();
+    }
+
+    template <typename T>
+    static bool Finish(bool ok, std::vector<T>& out, size_t first)
+    {
+        if (!ok) out.resize(first);
+        return ok;
+    }
+
+    // Compares `key` against a literal without building a std::string.
+    template <size_t N>
+    static bool Is(const std::string& key, const char (&lit)[N])
+    {
+        return key.size() == N - 1 && std::memcmp(key.data(), lit, N - 1) == 0;
+    }
+
+    class AchievementReader : public Reader {
+    public:
+        AchievementReader(std::vector<Achievement>& out, uint32_t* build) : m_Out(out), m_Build(build) {}
+
+    private:
+        enum Field { F_None, F_Id, F_Name, F_Description, F_Requirement, F_LockedText,
+                     F_Type, F_Icon, F_Flags, F_Bits, F_Tiers };
+        enum BitField { B_None, B_Type, B_Id, B_Text, B_Count, B_Points };  // bit or tier member
+        enum RootField { R_None, R_Build, R_Achievements };
+
+        // Records are the objects directly inside the array at m_List
+        int  RecordDepth() const { return m_List + 1; }
+
+        void OnOpen(bool array) override
+        {
+            if (m_List < 0) {
+                // The record array is either the root or the legacy "achievements" member
+                if (array && (m_Depth == 1 || (m_Depth == 2 && m_Root == R_Achievements))) {
+                    m_List    = m_Depth;
+                    m_HadList = true;
+                }
+                return;
+            }
+            if (!array && m_Depth == RecordDepth()) {
+                m_Out.emplace_back();
+                m_Cur   = &m_Out.back();
+                m_Field = F_None;
+            } else if (array && m_Cur && m_Depth == RecordDepth() + 1) {
+                m_InFlags = m_Field == F_Flags;
+                m_InBits  = m_Field == F_Bits;
+                m_InTiers = m_Field == F_Tiers;
+            } else if (!array && m_InBits && m_Depth == RecordDepth() + 2) {
+                m_Cur->bits.emplace_back();
+                m_Bit      = &m_Cur->bits.back();
+                m_BitField = B_None;
+            } else if (!array && m_InTiers && m_Depth == RecordDepth() + 2) {
+                m_Cur->tiers.emplace_back();
+                m_Tier     = &m_Cur->tiers.back();
+                m_BitField = B_None;
+            }
+        }
+
+        // The root array, or the legacy object's "achievements" member
+        bool Complete() const override { return m_HadList; }
+
+        void OnClose(bool array) override
+        {
+            if (m_List < 0) return;
+            if (m_Depth == m_List && array) { m_List = -1; m_Root = R_None; }
+            else if (m_Depth == RecordDepth())     m_Cur = nullptr;
+            else if (m_Depth == RecordDepth() + 1) m_InFlags = m_InBits = m_InTiers = false;
+            else if (m_Depth == RecordDepth() + 2) { m_Bit = nullptr; m_Tier = nullptr; }
+        }
+
+        void OnKey(const std::string& k) override
+        {
+            if (m_List < 0) {
+                if (m_Depth == 1)
+                    m_Root = Is(k, "build") ? R_Build : Is(k, "achievements") ? R_Achievements : R_None;
+            } else if (m_Cur && m_Depth == RecordDepth()) {
+                m_Field = Is(k, "id")          ? F_Id
+                        : Is(k, "name")        ? F_Name
+                        : Is(k, "description") ? F_Description
+                        : Is(k, "requirement") ? F_Requirement
+                        : Is(k, "locked_text") ? F_LockedText
+                        : Is(k, "type")        ? F_Type
+                        : Is(k, "icon")        ? F_Icon
+                        : Is(k, "flags")       ? F_Flags
+                        : Is(k, "bits")        ? F_Bits
+                        : Is(k, "tiers")       ? F_Tiers
+                        :                        F_None;
+            } else if (m_Bit && m_Depth == RecordDepth() + 2) {
+                m_BitField = Is(k, "type") ? B_Type : Is(k, "id") ? B_Id : Is(k, "text") ? B_Text : B_None;
+            } else if (m_Tier && m_Depth == RecordDepth() + 2) {
+                m_BitField = Is(k, "count") ? B_Count : Is(k, "points") ? B_Points : B_None;
+            }
+        }
+
+        void OnInt(int64_t v) override
+        {
+            if (m_List < 0) {
+                if (m_Depth == 1 && m_Root == R_Build && m_Build) *m_Build = (uint32_t)v;
+            } else if (m_Cur && m_Depth == RecordDepth() && m_Field == F_Id) {
+                m_Cur->id = (int)v;
+            } else if (m_Bit && m_Depth == RecordDepth() + 2 && m_BitField == B_Id) {
+                m_Bit->id = (int)v;
+            } else if (m_Tier && m_Depth == RecordDepth() + 2) {
+                if (m_BitField == B_Count)       m_Tier->count  = (int)v;
+                else if (m_BitField == B_Points) m_Tier->points = (int)v;
+            }
+        }
+
+        void OnString(std::string& v) override
+        {
+            if (!m_Cur) return;
+            if (m_Depth == RecordDepth()) {
+                switch (m_Field) {
+                case F_Name:        m_Cur->name        = std::move(v); break;
+                case F_Description: m_Cur->description = PooledString(v); break;
+                case F_Requirement: m_Cur->requirement = PooledString(v); break;
+                case F_LockedText:  m_Cur->locked_text = PooledString(v); break;
+                case F_Type:        m_Cur->type        = ParseAchievementType(v); break;
+                case F_Icon:        m_Cur->icon        = PooledString(v); break;
+                default: break;
+                }
+            } else if (m_InFlags && m_Depth == RecordDepth() + 1) {
+                m_Cur->flags |= ParseAchievementFlag(v);
+            } else if (m_Bit && m_Depth == RecordDepth() + 2) {
+                if (m_BitField == B_Type)      m_Bit->type = ParseBitType(v);
+                else if (m_BitField == B_Text) m_Bit->text = PooledString(v);
+            }
+        }
+
+        std::vector<Achievement>& m_Out;
+        uint32_t*       m_Build;
+        int             m_List     = -1;
+        bool            m_HadList  = false;
+        RootField       m_Root     = R_None;
+        Achievement*    m_Cur      = nullptr;
+        AchievementBit* m_Bit      = nullptr;
+        AchievementTier* m_Tier    = nullptr;
+        Field           m_Field    = F_None;
+        BitField        m_BitField = B_None;
+        bool            m_InFlags  = false;
+        bool            m_InBits   = false;
+        bool            m_InTiers  = false;
+    };
+
+    class ItemReader : public Reader {
+    public:
+        explicit ItemReader(std::vector<Item>& out) : m_Out(out) {}
+
+    private:
+        enum Field { F_None, F_Id, F_Name, F_Description, F_Type, F_Rarity, F_Icon, F_ChatLink };
+
+        void OnOpen(bool array) override
+        {
+            if (!array && m_Depth == 2) { m_Out.emplace_back(); m_Cur = &m_Out.back(); m_Field = F_None; }
+        }
+        void OnClose(bool array) override
+        {
+            if (!array && m_Depth == 2) m_Cur = nullptr;
+        }
+        void OnKey(const std::string& k) override
+        {
+            if (!m_Cur || m_Depth != 2) return;
+            m_Field = Is(k, "id")          ? F_Id
+                    : Is(k, "name")        ? F_Name
+                    : Is(k, "description") ? F_Description
+                    : Is(k, "type")        ? F_Type
+                    : Is(k, "rarity")      ? F_Rarity
+                    : Is(k, "icon")        ? F_Icon
+                    : Is(k, "chat_link")   ? F_ChatLink
+                    :                        F_None;
+        }
+        void OnInt(int64_t v) override
+        {
+            if (m_Cur && m_Depth == 2 && m_Field == F_Id) m_Cur->id = (int)v;
+        }
+        void OnString(std::string& v) override
+        {
+            if (!m_Cur || m_Depth != 2) return;
+            switch (m_Field) {
+            case F_Name:        m_Cur->name        = std::move(v); break;
+            case F_Description: m_Cur->description = std::move(v); break;
+            case F_Type:        m_Cur->type        = std::move(v); break;
+            case F_Rarity:      m_Cur->rarity      = std::move(v); break;
+            case F_Icon:        m_Cur->icon        = std::move(v); break;
+            case F_ChatLink:    m_Cur->chat_link   = std::move(v); break;
+            default: break;
+            }
+        }
+
+        std::vector<Item>& m_Out;
+        Item*  m_Cur   = nullptr;
+        Field  m_Field = F_None;
+    };
+
+    class ProgressReader : public Reader {
+    public:
+        explicit ProgressReader(std::vector<AccountAchievement>& out) : m_Out(out) {}
+
+    private:
+        enum Field { F_None, F_Id, F_Current, F_Max, F_Done, F_Bits };
+
+        void OnOpen(bool array) override
+        {
+            if (!array && m_Depth == 2) { m_Out.emplace_back(); m_Cur = &m_Out.back(); m_Field = F_None; }
+        }
+        void OnClose(bool array) override
+        {
+            if (!array && m_Depth == 2) m_Cur = nullptr;
+        }
+        void OnKey(const std::string& k) override
+        {
+            if (!m_Cur || m_Depth != 2) return;
+            m_Field = Is(k, "id")      ? F_Id
+                    : Is(k, "current") ? F_Current
+                    : Is(k, "max")     ? F_Max
+                    : Is(k, "done")    ? F_Done
+                    : Is(k, "bits")    ? F_Bits
+                    :                    F_None;
+        }
+        void OnInt(int64_t v) override
+        {
+            if (!m_Cur) return;
+            if (m_Depth == 3 && m_Field == F_Bits) { m_Cur->bits.push_back((int)v); return; }
+            if (m_Depth != 2) return;
+            switch (m_Field) {
+            case F_Id:      m_Cur->id      = (int)v; break;
+            case F_Current: m_Cur->current = (int)v; break;
+            case F_Max:     m_Cur->max     = (int)v; break;
+            case F_Done:    m_Cur->done    = v != 0; break;
+            default: break;
+            }
+        }
+
+        std::vector<AccountAchievement>& m_Out;
+        AccountAchievement* m_Cur   = nullptr;
+        Field               m_Field = F_None;
+    };
+
+    class CategoryReader : public Reader {
+    public:
+        explicit CategoryReader(std::vector<AchievementCategory>& out) : m_Out(out) {}
+
+    private:
+        enum Field { F_None, F_Id, F_Order, F_Name, F_Icon, F_Achievements };
+
+        void OnOpen(bool array) override
+        {
+            if (!array && m_Depth == 2) { m_Out.emplace_back(); m_Cur = &m_Out.back(); m_Field = F_None; }
+        }
+        void OnClose(bool array) override
+        {
+            if (!array && m_Depth == 2) m_Cur = nullptr;
+        }
+        void OnKey(const std::string& k) override
+        {
+            if (!m_Cur || m_Depth != 2) return;
+            m_Field = Is(k, "id")           ? F_Id
+                    : Is(k, "order")        ? F_Order
+                    : Is(k, "name")         ? F_Name
+                    : Is(k, "icon")         ? F_Icon
+                    : Is(k, "achievements") ? F_Achievements
+                    :                         F_None;
+        }
+        void OnInt(int64_t v) override
+        {
+            if (!m_Cur) return;
+            if (m_Depth == 3 && m_Field == F_Achievements) { m_Cur->achievements.push_back((int)v); return; }
+            if (m_Depth != 2) return;
+            if (m_Field == F_Id)    m_Cur->id    = (int)v;
+            if (m_Field == F_Order) m_Cur->order = (int)v;
+        }
+        void OnString(std::string& v) override
+        {
+            if (!m_Cur || m_Depth != 2) return;
+            if (m_Field == F_Name) m_Cur->name = std::move(v);
+            if (m_Field == F_Icon) m_Cur->icon = std::move(v);
+        }
+
+        std::vector<AchievementCategory>& m_Out;
+        AchievementCategory* m_Cur   = nullptr;
+        Field                m_Field = F_None;
+    };
+
+    class GroupReader : public Reader {
+    public:
+        explicit GroupReader(std::vector<AchievementGroup>& out) : m_Out(out) {}
+
+    private:
+        enum Field { F_None, F_Id, F_Order, F_Name, F_Categories };
+
+        void OnOpen(bool array) override
+        {
+            if (!array && m_Depth == 2) { m_Out.emplace_back(); m_Cur = &m_Out.back(); m_Field = F_None; }
+        }
+        void OnClose(bool array) override
+        {
+            if (!array && m_Depth == 2) m_Cur = nullptr;
+        }
+        void OnKey(const std::string& k) override
+        {
+            if (!m_Cur || m_Depth != 2) return;
+            m_Field = Is(k, "id")         ? F_Id
+                    : Is(k, "order")      ? F_Order
+                    : Is(k, "name")       ? F_Name
+                    : Is(k, "categories") ? F_Categories
+                    :                       F_None;
+        }
+        void OnInt(int64_t v) override
+        {
+            if (!m_Cur) return;
+            if (m_Depth == 3 && m_Field == F_Categories) { m_Cur->categories.push_back((int)v); return; }
+            if (m_Depth == 2 && m_Field == F_Order) m_Cur->order = (int)v;
+        }
+        void OnString(std::string& v) override
+        {
+            if (!m_Cur || m_Depth != 2) return;
+            if (m_Field == F_Id)   m_Cur->id   = std::move(v);
+            if (m_Field == F_Name) m_Cur->name = std::move(v);
+        }
+
+        std::vector<AchievementGroup>& m_Out;
+        AchievementGroup* m_Cur   = nullptr;
+        Field             m_Field = F_None;
+    };
+
+    class IdReader : public Reader {
+    public:
+        explicit IdReader(std::vector<int>& out) : m_Out(out) {}
+
+    private:
+        void OnInt(int64_t v) override
+        {
+            if (m_Depth == 1) m_Out.push_back((int)v);
+        }
+
+        std::vector<int>& m_Out;
+    };
+
+    bool ParseAchievements(std::string_view body, std::vector<Achievement>& out, uint32_t* build)
+    {
+        Metrics::ScopedTimer timer(MetricTimer_Parse);
+        Trace::Span span("parse", "ParseAchievements");
+        size_t first = out.size();
+        AchievementReader reader(out, build);
+        return Finish(Run(body, reader), out, first);
+    }
+
+    bool ParseItems(std::string_view body, std::vector<Item>& out)
+    {
+        Metrics::ScopedTimer timer(MetricTimer_Parse);
+        Trace::Span span("parse", "ParseItems");
+        size_t first = out.size();
+        ItemReader reader(out);
+        return Finish(Run(body, reader), out, first);
+    }
+
+    bool ParseAccountAchievements(std::string_view body, std::vector<AccountAchievement>& out)
+    {
+        Metrics::ScopedTimer timer(MetricTimer_Parse);
+        Trace::Span span("parse", "ParseAccountAchievements");
+        size_t first = out.size();
+        ProgressReader reader(out);
+        return Finish(Run(body, reader), out, first);
+    }
+
+    bool ParseCategories(std::string_view body, std::vector<AchievementCategory>& out)
+    {
+        Metrics::ScopedTimer timer(MetricTimer_Parse);
+        size_t first = out.size();
+        CategoryReader reader(out);
+        return Finish(Run(body, reader), out, first);
+    }
+
+    bool ParseGroups(std::string_view body, std::vector<AchievementGroup>& out)
+    {
+        Metrics::ScopedTimer timer(MetricTimer_Parse);
+        size_t first = out.size();
+        GroupReader reader(out);
+        return Finish(Run(body, reader), out, first);
+    }
+
+    bool ParseIds(std::string_view body, std::vector<int>& out)
+    {
+        size_t first = out.size();
+        IdReader reader(out);
+        return Finish(Run(body, reader), out, first);
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "GW2Api.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Streaming (SAX) readers for GW2 API responses. Records are filled straight from
+// the bytes without building a JSON DOM first, which roughly halves peak memory
+// on large batches and skips one allocation per value. Unknown fields are
+// skipped. On malformed input, or a root that is not the expected array (an
+// error object, say), nothing is appended and false is returned.
+namespace ApiJson {
+
+    // Accepts a bare array of achievements, or the legacy cache object
+    // { "build": N, "achievements": [...] }, whose build id goes to `build`.
+    bool ParseAchievements(std::string_view body, std::vector<Achievement>& out, uint32_t* build = nullptr);
+    bool ParseItems(std::string_view body, std::vector<Item>& out);
+    bool ParseAccountAchievements(std::string_view body, std::vector<AccountAchievement>& out);
+    bool ParseCategories(std::string_view body, std::vector<AchievementCategory>& out);
+    bool ParseGroups(std::string_view body, std::vector<AchievementGroup>& out);
+    // A bare array of ids, as returned by the unparameterized list endpoints.
+    bool ParseIds(std::string_view body, std::vector<int>& out);
+}
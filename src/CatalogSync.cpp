@@ -0,0 +1,98 @@
+#include "CatalogSync.h"
+#include "GW2Api.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace CatalogSync {
+
+    Stats Run(const std::vector<int>& ids, const Options& opts,
+              const FetchBatchFn& fetch, const ParseBatchFn& parse,
+              std::vector<Achievement>& out, const std::atomic<bool>& cancel)
+    {
+        Stats stats;
+        auto start = std::chrono::steady_clock::now();
+
+        const size_t batchSize  = (size_t)std::max(1, opts.BatchSize);
+        const size_t batchCount = (ids.size() + batchSize - 1) / batchSize;
+        const int    fetchers   = std::max(1, std::min(opts.MaxInFlight, (int)batchCount));
+        const int    parsers    = std::max(1, opts.ParseWorkers);
+
+        std::atomic<size_t>     nextBatch{0};
+        std::atomic<int>        failed{0};
+        std::mutex              queueMutex;
+        std::condition_variable queueCv;
+        std::deque<std::string> bodies;   // completed responses waiting to be parsed
+        std::vector<std::string> spare;   // parsed bodies, kept for their capacity
+        int                     fetchersLeft = fetchers;
+        std::mutex              outMutex;
+
+        auto fetchWorker = [&]() {
+            Trace::SetThreadName("CatalogFetch");
+            for (;;) {
+                size_t b = nextBatch.fetch_add(1);
+                if (b >= batchCount || cancel) break;
+                size_t first = b * batchSize;
+                std::vector<int> batch(ids.begin() + first,
+                    ids.begin() + std::min(first + batchSize, ids.size()));
+                std::string body;
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex);
+                    if (!spare.empty()) { body = std::move(spare.back()); spare.pop_back(); }
+                }
+                bool ok = fetch(batch, body) && !body.empty();
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex);
+                    if (ok) bodies.push_back(std::move(body));
+                    else    spare.push_back(std::move(body));
+                }
+                if (!ok) { ++failed; continue; }
+                queueCv.notify_one();
+            }
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                --fetchersLeft;
+            }
+            queueCv.notify_all();
+        };
+
+        auto parseWorker = [&]() {
+            Trace::SetThreadName("CatalogParse");
+            std::vector<Achievement> local;
+            for (;;) {
+                std::string body;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    queueCv.wait(lock, [&]() { return !bodies.empty() || fetchersLeft == 0; });
+                    if (bodies.empty()) break;
+                    body = std::move(bodies.front());
+                    bodies.pop_front();
+                }
+                if (!cancel) parse(body, local);
+                std::lock_guard<std::mutex> lock(queueMutex);
+                spare.push_back(std::move(body));
+            }
+            std::lock_guard<std::mutex> lock(outMutex);
+            out.insert(out.end(), std::make_move_iterator(local.begin()),
+                                  std::make_move_iterator(local.end()));
+        };
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < fetchers; ++i) threads.emplace_back(fetchWorker);
+        for (int i = 0; i < parsers;  ++i) threads.emplace_back(parseWorker);
+        for (auto& t : threads) t.join();
+
+        stats.Batches       = (int)std::min(nextBatch.load(), batchCount);
+        stats.FailedBatches = failed;
+        stats.Achievements  = (int)out.size();
+        stats.WallSeconds   = std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - start).count();
+        if (stats.WallSeconds > 0.0)
+            stats.BatchesPerSec = stats.Batches / stats.WallSeconds;
+        return stats;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct Achievement;
+
+namespace CatalogSync {
+
+    struct Options {
+        int BatchSize    = 200;
+        int MaxInFlight  = 4;   // batch requests outstanding at once
+        int ParseWorkers = 2;
+    };
+
+    struct Stats {
+        int    Batches       = 0;
+        int    FailedBatches = 0;
+        int    Achievements  = 0;
+        double WallSeconds   = 0.0;
+        double BatchesPerSec = 0.0;
+    };
+
+    // Fills `body` with the raw response for one batch of ids; false on failure.
+    // Bodies are recycled between batches, so `body` usually arrives with capacity.
+    using FetchBatchFn = std::function<bool(const std::vector<int>& ids, std::string& body)>;
+    // Appends every achievement found in one response body to `out`.
+    using ParseBatchFn = std::function<void(const std::string& body, std::vector<Achievement>& out)>;
+
+    // Downloads `ids` in batches with up to MaxInFlight requests outstanding while
+    // ParseWorkers threads parse completed responses. Nothing is merged here; the
+    // caller gets every parsed achievement in `out` and inserts them in one go.
+    Stats Run(const std::vector<int>& ids, const Options& opts,
+              const FetchBatchFn& fetch, const ParseBatchFn& parse,
+              std::vector<Achievement>& out, const std::atomic<bool>& cancel);
+}
@@ -0,0 +1,328 @@
+#include "FullTextIndex.h"
+#include "GW2Api.h"
+#include "NameSearch.h"
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <queue>
+
+namespace FullText {
+
+    static constexpr float FIELD_WEIGHT[Field_Count] = {
+        8.0f,   // Name
+        1.5f,   // Description
+        2.0f,   // Requirement
+        1.5f,   // BitText
+        3.0f,   // ItemName
+    };
+
+    static constexpr float MATCH_EXACT  = 1.0f;
+    static constexpr float MATCH_PREFIX = 0.75f;
+    static constexpr float MATCH_INFIX  = 0.5f;
+
+    static constexpr size_t MAX_QUERY_TOKENS = 8;
+
+    static uint32_t Trigram(const std::string& s, size_t i)
+    {
+        return ((uint32_t)(unsigned char)s[i] << 16) |
+               ((uint32_t)(unsigned char)s[i + 1] << 8) |
+                (uint32_t)(unsigned char)s[i + 2];
+    }
+
+    void Tokenize(std::string_view folded, std::vector<std::string>& out)
+    {
+        out.clear();
+        std::string cur;
+        for (char ch : folded) {
+            unsigned char c = (unsigned char)ch;
+            if (c == '\'') continue;
+            if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c >= 0x80) {
+                cur += ch;
+            } else if (!cur.empty()) {
+                out.push_back(std::move(cur));
+                cur.clear();
+            }
+        }
+        if (!cur.empty()) out.push_back(std::move(cur));
+    }
+
+    static void FoldAndTokenize(std::string_view text, std::vector<std::string>& out)
+    {
+        std::string folded;
+        NameSearch::Fold(text, folded);
+        Tokenize(folded, out);
+    }
+
+    uint32_t Index::TokenId(const std::string& token)
+    {
+        auto it = m_TokenIds.find(token);
+        if (it != m_TokenIds.end()) return it->second;
+
+        uint32_t id = (uint32_t)m_Tokens.size();
+        m_Tokens.push_back(token);
+        m_TokenIds.emplace(token, id);
+        m_Postings.emplace_back();
+        for (size_t i = 0; i + 3 <= token.size(); ++i) {
+            auto& list = m_Trigrams[Trigram(token, i)];
+            if (list.empty() || list.back() != id) list.push_back(id);
+        }
+        return id;
+    }
+
+    void Index::Post(uint32_t slot, Field field, const std::vector<std::string>& tokens)
+    {
+        std::vector<uint32_t> ids;
+        ids.reserve(tokens.size());
+        for (const auto& t : tokens) ids.push_back(TokenId(t));
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        for (uint32_t id : ids) {
+            m_Postings[id].push_back({ slot, field });
+            m_DocTokens[slot].push_back({ id, field });
+        }
+    }
+
+    void Index::Retire(int id)
+    {
+        auto it = m_SlotOf.find(id);
+        if (it == m_SlotOf.end()) return;
+        m_SlotIds[it->second] = 0;
+        std::vector<std::pair<uint32_t, Field>>().swap(m_DocTokens[it->second]);
+        m_SlotOf.erase(it);
+        ++m_DeadSlots;
+    }
+
+    // Drops postings of replaced documents once they outnumber the live ones.
+    void Index::Compact()
+    {
+        if (m_DeadSlots < 1000 || m_DeadSlots < m_SlotOf.size()) return;
+        auto dead = [this](uint32_t slot) { return m_SlotIds[slot] == 0; };
+        for (auto& list : m_Postings)
+            list.erase(std::remove_if(list.begin(), list.end(),
+                [&](const Posting& p) { return dead(p.Slot); }), list.end());
+        for (auto& kv : m_ItemSlots)
+            kv.second.erase(std::remove_if(kv.second.begin(), kv.second.end(), dead), kv.second.end());
+        m_DeadSlots = 0;
+    }
+
+    void Index::AddAchievement(const Achievement& ach)
+    {
+        Document doc;
+        doc.Id          = ach.id;
+        doc.Name        = ach.name;
+        doc.Description = ach.description;
+        doc.Requirement = ach.requirement;
+        for (const auto& bit : ach.bits) {
+            if (bit.type == BitType_Item) doc.ItemIds.push_back(bit.id);
+            if (!bit.text.empty()) doc.BitText.push_back(bit.text);
+        }
+        AddDocument(doc);
+    }
+
+    void Index::AddDocument(const Document& doc)
+    {
+        std::vector<std::string> name, desc, req, bitText;
+        FoldAndTokenize(doc.Name, name);
+        FoldAndTokenize(doc.Description, desc);
+        FoldAndTokenize(doc.Requirement, req);
+        std::vector<std::string> tokens;
+        for (std::string_view text : doc.BitText) {
+            FoldAndTokenize(text, tokens);
+            bitText.insert(bitText.end(), tokens.begin(), tokens.end());
+        }
+
+        std::unique_lock<std::shared_mutex> lock(m_Mutex);
+        Retire(doc.Id);
+        Compact();
+
+        uint32_t slot = (uint32_t)m_SlotIds.size();
+        m_SlotIds.push_back(doc.Id);
+        m_DocTokens.emplace_back();
+        m_SlotOf[doc.Id] = slot;
+        ++m_Generation;
+
+        Post(slot, Field_Name,        name);
+        Post(slot, Field_Description, desc);
+        Post(slot, Field_Requirement, req);
+        Post(slot, Field_BitText,     bitText);
+        for (int itemId : doc.ItemIds) {
+            m_ItemSlots[itemId].push_back(slot);
+            auto it = m_ItemTokens.find(itemId);
+            if (it != m_ItemTokens.end()) Post(slot, Field_ItemName, it->second);
+        }
+    }
+
+    void Index::Remove(int id)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_Mutex);
+        Retire(id);
+        ++m_Generation;
+    }
+
+    void Index::AddItem(int itemId, std::string_view name)
+    {
+        std::vector<std::string> tokens;
+        FoldAndTokenize(name, tokens);
+
+        std::unique_lock<std::shared_mutex> lock(m_Mutex);
+        if (m_ItemTokens.count(itemId)) return;
+        auto slots = m_ItemSlots.find(itemId);
+        if (slots != m_ItemSlots.end())
+            for (uint32_t slot : slots->second)
+                if (m_SlotIds[slot] != 0) Post(slot, Field_ItemName, tokens);
+        m_ItemTokens.emplace(itemId, std::move(tokens));
+        ++m_Generation;
+    }
+
+    size_t Index::DocumentCount() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_Mutex);
+        return m_SlotOf.size();
+    }
+
+    void Index::MatchToken(const std::string& q, std::vector<std::pair<uint32_t, float>>& out) const
+    {
+        out.clear();
+        auto exact = m_TokenIds.find(q);
+        if (exact != m_TokenIds.end()) out.push_back({ exact->second, MATCH_EXACT });
+
+        if (q.size() < 3) {
+            // Too short for trigrams; only prefixes are specific enough to be useful
+            for (uint32_t t = 0; t < m_Tokens.size(); ++t)
+                if (m_Tokens[t].size() > q.size() && m_Tokens[t].compare(0, q.size(), q) == 0)
+                    out.push_back({ t, MATCH_PREFIX });
+            return;
+        }
+
+        const std::vector<uint32_t>* smallest = nullptr;
+        for (size_t i = 0; i + 3 <= q.size(); ++i) {
+            auto it = m_Trigrams.find(Trigram(q, i));
+            if (it == m_Trigrams.end()) return;
+            if (!smallest || it->second.size() < smallest->size()) smallest = &it->second;
+        }
+        for (uint32_t t : *smallest) {
+            const std::string& tok = m_Tokens[t];
+            if (tok.size() <= q.size()) continue;
+            size_t pos = tok.find(q);
+            if (pos != std::string::npos)
+                out.push_back({ t, pos == 0 ? MATCH_PREFIX : MATCH_INFIX });
+        }
+    }
+
+    std::vector<Hit> Index::Query(std::string_view query, size_t k, const QueryOptions& opts) const
+    {
+        std::vector<std::string> tokens;
+        FoldAndTokenize(query, tokens);
+        if (tokens.size() > MAX_QUERY_TOKENS) tokens.resize(MAX_QUERY_TOKENS);
+        const auto* boosts = opts.Boosts;
+        if (tokens.empty() && (!boosts || boosts->empty())) return {};
+        auto cancelled = [&]() { return opts.Cancel && opts.Cancel->load(std::memory_order_relaxed); };
+
+        struct Acc { float Score = 0.f; uint32_t Mask = 0; };
+        std::unordered_map<uint32_t, Acc> acc;
+        using FieldScores = std::array<float, Field_Count>;
+        auto addScores = [&](uint32_t slot, size_t qi, const FieldScores& best) {
+            float s = 0.f;
+            for (int f = 0; f < Field_Count; ++f) s += FIELD_WEIGHT[f] * best[f];
+            if (s <= 0.f) return;
+            Acc& a = acc[slot];
+            a.Score += s;
+            a.Mask  |= 1u << qi;
+        };
+
+        std::shared_lock<std::shared_mutex> lock(m_Mutex);
+
+        // Vocabulary tokens each query token matches, and the postings they cover
+        std::vector<std::vector<std::pair<uint32_t, float>>> matches(tokens.size());
+        size_t postings = 0;
+        for (size_t qi = 0; qi < tokens.size(); ++qi) {
+            MatchToken(tokens[qi], matches[qi]);
+            for (const auto& m : matches[qi]) postings += m_Postings[m.first].size();
+        }
+
+        // Narrowing scores only the previous candidates: by looking their own tokens
+        // up when those are fewer than the postings, else by walking the postings
+        // and skipping everything else
+        std::vector<uint32_t> candidates;
+        std::vector<bool>     within;
+        bool perCandidate = false;
+        if (opts.Within) {
+            size_t docTokens = 0;
+            for (int id : *opts.Within) {
+                auto slot = m_SlotOf.find(id);
+                if (slot == m_SlotOf.end()) continue;
+                candidates.push_back(slot->second);
+                docTokens += m_DocTokens[slot->second].size();
+            }
+            perCandidate = docTokens * tokens.size() < postings;
+            if (!perCandidate) {
+                within.resize(m_SlotIds.size());
+                for (uint32_t slot : candidates) within[slot] = true;
+            }
+        }
+
+        if (perCandidate) {
+            std::vector<float> quality;  // by vocabulary token id
+            for (size_t qi = 0; qi < tokens.size(); ++qi) {
+                if (cancelled()) return {};
+                quality.assign(m_Tokens.size(), 0.f);
+                for (const auto& m : matches[qi]) quality[m.first] = m.second;
+                for (uint32_t slot : candidates) {
+                    FieldScores best{};
+                    for (const auto& dt : m_DocTokens[slot]) {
+                        float& f = best[dt.second];
+                        f = std::max(f, quality[dt.first]);
+                    }
+                    addScores(slot, qi, best);
+                }
+            }
+        } else {
+            std::unordered_map<uint32_t, FieldScores> best;
+            for (size_t qi = 0; qi < tokens.size(); ++qi) {
+                if (cancelled()) return {};
+                best.clear();
+                // Per document and field, only the best-matching vocabulary token counts
+                for (const auto& m : matches[qi])
+                    for (const Posting& p : m_Postings[m.first]) {
+                        if (m_SlotIds[p.Slot] == 0 || (opts.Within && !within[p.Slot])) continue;
+                        auto ins = best.try_emplace(p.Slot);
+                        if (ins.second) ins.first->second.fill(0.f);
+                        float& f = ins.first->second[p.Source];
+                        f = std::max(f, m.second);
+                    }
+                for (const auto& kv : best) addScores(kv.first, qi, kv.second);
+            }
+        }
+        if (cancelled()) return {};
+
+        const uint32_t full = tokens.empty() ? 0 : (1u << tokens.size()) - 1;
+        auto worse = [](const Hit& a, const Hit& b) {
+            return a.Score != b.Score ? a.Score > b.Score : a.Id < b.Id;
+        };
+        // Min-heap of the best k so far: the top is the weakest kept hit
+        std::priority_queue<Hit, std::vector<Hit>, decltype(worse)> heap(worse);
+        auto offer = [&](Hit h) {
+            if (opts.Matched) opts.Matched->push_back(h.Id);
+            if (k == 0) return;
+            if (heap.size() < k) heap.push(h);
+            else if (worse(h, heap.top())) { heap.pop(); heap.push(h); }
+        };
+
+        for (const auto& kv : acc) {
+            int id = m_SlotIds[kv.first];
+            bool boosted = boosts && boosts->count(id);
+            if (kv.second.Mask != full && !boosted) continue;
+            offer({ id, kv.second.Score + (boosted ? boosts->at(id) : 0.f) });
+        }
+        if (boosts)
+            for (const auto& kv : *boosts) {
+                auto slot = m_SlotOf.find(kv.first);
+                if (slot == m_SlotOf.end() || !acc.count(slot->second))
+                    offer({ kv.first, kv.second });
+            }
+
+        std::vector<Hit> hits(heap.size());
+        for (size_t i = hits.size(); i-- > 0; ) { hits[i] = heap.top(); heap.pop(); }
+        return hits;
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct Achievement;
+
+namespace FullText {
+
+    enum Field : uint8_t {
+        Field_Name,
+        Field_Description,
+        Field_Requirement,
+        Field_BitText,
+        Field_ItemName,
+        Field_Count
+    };
+
+    struct Hit {
+        int   Id;
+        float Score;
+    };
+
+    struct QueryOptions {
+        // Flat score per id; these ids qualify even without a full token match.
+        const std::unordered_map<int, float>* Boosts  = nullptr;
+        // Only score these ids. When their tokens are fewer than the postings a
+        // fresh query would walk, each one's own tokens are looked up instead of
+        // the postings. Used to narrow a previous result set.
+        const std::vector<int>*               Within  = nullptr;
+        // Receives every qualifying id, not just the top k.
+        std::vector<int>*                     Matched = nullptr;
+        // Polled while scoring; a cancelled query returns no hits.
+        const std::atomic<bool>*              Cancel  = nullptr;
+    };
+
+    // Splits already-folded text into word tokens. Apostrophes are dropped so
+    // "hero's" and "heros" index the same.
+    void Tokenize(std::string_view folded, std::vector<std::string>& out);
+
+    // Inverted index over achievement text. Token postings carry the field they
+    // came from for weighting; a trigram index over the token vocabulary lets
+    // partial words ("mistfor") match. Documents can be added or replaced at any
+    // time from any thread while queries run.
+    // The searchable text of one achievement.
+    struct Document {
+        int                           Id = 0;
+        std::string_view              Name;
+        std::string_view              Description;
+        std::string_view              Requirement;
+        std::vector<std::string_view> BitText;
+        std::vector<int>              ItemIds;   // items linked from bits
+    };
+
+    class Index {
+    public:
+        // Indexes (or re-indexes) one achievement, including the names of any
+        // items its bits link to that are already known.
+        void AddAchievement(const Achievement& ach);
+        void AddDocument(const Document& doc);
+        void Remove(int id);
+        // Adds an item's name to every achievement that links to it, now or later.
+        void AddItem(int itemId, std::string_view name);
+
+        // Top `k` achievements containing every query token, best first.
+        std::vector<Hit> Query(std::string_view query, size_t k,
+                               const QueryOptions& opts = {}) const;
+
+        size_t   DocumentCount() const;
+        // Bumped on every change, so cached result sets can tell they are stale.
+        uint64_t Generation() const { return m_Generation.load(); }
+
+    private:
+        struct Posting {
+            uint32_t Slot;
+            Field    Source;
+        };
+
+        uint32_t TokenId(const std::string& token);
+        void     Post(uint32_t slot, Field field, const std::vector<std::string>& tokens);
+        void     MatchToken(const std::string& q, std::vector<std::pair<uint32_t, float>>& out) const;
+        void     Retire(int id);
+        void     Compact();
+
+        mutable std::shared_mutex m_Mutex;
+
+        std::vector<int>                   m_SlotIds;   // slot -> achievement id, 0 once replaced
+        std::unordered_map<int, uint32_t>  m_SlotOf;    // achievement id -> live slot
+        size_t                             m_DeadSlots = 0;
+        std::atomic<uint64_t>              m_Generation{0};
+
+        std::vector<std::string>                  m_Tokens;
+        std::unordered_map<std::string, uint32_t> m_TokenIds;
+        std::vector<std::vector<Posting>>         m_Postings;   // by token id
+        std::vector<std::vector<std::pair<uint32_t, Field>>> m_DocTokens; // by slot: (token id, field)
+        std::unordered_map<uint32_t, std::vector<uint32_t>> m_Trigrams; // trigram -> token ids
+
+        std::unordered_map<int, std::vector<std::string>> m_ItemTokens;
+        std::unordered_map<int, std::vector<uint32_t>>    m_ItemSlots;  // item id -> slots linking to it
+    };
+}
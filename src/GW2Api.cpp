@@ -1,451 +1,1073 @@
 #include "GW2Api.h"
 #include "Shared.h"
-#include <winhttp.h>
+#include "HttpTransport.h"
+#include "AchievementCache.h"
+#include "ApiJson.h"
+#include "IconCache.h"
+#include "NameSearch.h"
+#include "FullTextIndex.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include <cstdio>
 #include <sstream>
 #include <fstream>
 #include <thread>
 #include <mutex>
 #include <atomic>
-#include <cctype>
 #include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <random>
+#include <unordered_map>
 #include <unordered_set>
 #include <windows.h>
 
 using json = nlohmann::json;
 
+AchievementType ParseAchievementType(std::string_view s)
+{
+    return s == "ItemSet" ? AchievementType_ItemSet : AchievementType_Default;
+}
+
+uint32_t ParseAchievementFlag(std::string_view s)
+{
+    static const std::pair<std::string_view, uint32_t> FLAGS[] = {
+        { "Pvp",                  AchievementFlags_Pvp },
+        { "CategoryDisplay",      AchievementFlags_CategoryDisplay },
+        { "MoveToTop",            AchievementFlags_MoveToTop },
+        { "IgnoreNearlyComplete", AchievementFlags_IgnoreNearlyComplete },
+        { "Repeatable",           AchievementFlags_Repeatable },
+        { "Hidden",               AchievementFlags_Hidden },
+        { "RequiresUnlock",       AchievementFlags_RequiresUnlock },
+        { "RepairOnLogin",        AchievementFlags_RepairOnLogin },
+        { "Daily",                AchievementFlags_Daily },
+        { "Weekly",               AchievementFlags_Weekly },
+        { "Monthly",              AchievementFlags_Monthly },
+        { "Permanent",            AchievementFlags_Permanent },
+    };
+    for (const auto& f : FLAGS)
+        if (f.first == s) return f.second;
+    return 0;
+}
+
+BitType ParseBitType(std::string_view s)
+{
+    if (s == "Text")    return BitType_Text;
+    if (s == "Item")    return BitType_Item;
+    if (s == "Minipet") return BitType_Minipet;
+    if (s == "Skin")    return BitType_Skin;
+    return BitType_Unknown;
+}
+
 namespace GW2Api {
 
-    std::map<int, Achievement>        s_Achievements;
-    std::map<int, Item>                s_Items;
-    std::map<int, AccountAchievement>  s_AccountAchievements;
-    std::mutex                         s_Mutex;
+    SnapshotTable<Achievement>         s_Achievements;
+    SnapshotTable<Item>                s_Items;
+    SnapshotTable<AccountAchievement>  s_AccountAchievements;
+    std::mutex                         s_Mutex;  // cache reader, pending details, progress events and sync stats; never the tables
     std::atomic<bool>                  s_LoadingAll{false};
+    std::atomic<bool>                  s_PrefetchingItems{false};
+    std::atomic<bool>                  s_LoadingCategoryTree{false};
     std::atomic<bool>                  s_Shutdown{false};
-    std::unordered_set<std::string>    s_QueuedIcons;  // texNames already queued for download
+    CatalogSync::Stats                 s_LastSyncStats;
+    std::atomic<uint32_t>              s_CacheBuildId{0};  // game build the cached catalog was synced under
+    std::atomic<bool>                  s_CacheLoaded{false};
+    std::atomic<double>                s_CacheLoadSeconds{0.0};
+    AchievementCache::Reader           s_CacheReader;  // backs entries with details_loaded == false
+    std::mutex                         s_CacheFileMutex;  // held while the cache file is read without s_Mutex or replaced
+    std::unordered_set<int>            s_PendingDetails;  // requested or queued for the details worker
+    std::vector<int>                   s_DetailsQueue;
+    bool                               s_DetailsWorker = false;  // a worker is draining s_DetailsQueue
+    std::vector<ProgressEvent>         s_ProgressEvents;
+    std::unordered_set<int>            s_ProgressSeen;  // ids with a diff baseline; touched inside Update only
+    std::unordered_set<int>            s_ProgressFromDisk;  // entries still as the progress cache had them; ditto
+    std::mutex                         s_SaveMutex;  // item and progress cache writes share a temp file scheme
+    ProgressSyncCounters               s_ProgressSync;
+
+    std::shared_ptr<const NameSearch::Index> s_NameIndex;  // swapped whole, guarded by s_NameIndexMutex
+    std::mutex                         s_NameIndexMutex;
+    std::shared_ptr<const CategoryTree> s_CategoryTree;  // swapped whole; both guarded by s_CategoryMutex
+    std::unordered_set<int>            s_LoadingCategories;
+    std::mutex                         s_CategoryMutex;  // taken by the render thread, so never held for long
+    FullText::Index                    s_TextIndex;  // ranked multi-field search, fed as data arrives
+    CatalogMemory                      s_Memory;  // CatalogMemoryUsage of s_Achievements at s_MemoryGeneration
+    uint64_t                           s_MemoryGeneration = UINT64_MAX;
+    std::mutex                         s_MemoryMutex;
+
+    // Existing entries re-requested on every incremental refresh to pick up edits
+    static constexpr size_t REVALIDATE_SAMPLE = 200;
+    // Largest share of cached ids one incremental sync may drop as no longer listed
+    static constexpr double MAX_RETIRED_SHARE = 0.05;
 
     void Shutdown() { s_Shutdown = true; }
 
     static std::string CachePath()
     {
-        return std::string(APIDefs->Paths_GetAddonDirectory("AchievementTracker")) + "achievements_cache.json";
+        return std::string(APIDefs->Paths_GetAddonDirectory("AchievementTracker")) + "achievements_cache.bin";
     }
 
-    bool HasAchievementCache()
+    // JSON cache written by earlier versions; read only while no binary cache has
+    // been saved, and deleted by the first save that succeeds.
+    static std::string LegacyCachePath()
     {
-        std::ifstream f(CachePath());
-        return f.good();
+        return std::string(APIDefs->Paths_GetAddonDirectory("AchievementTracker")) + "achievements_cache.json";
     }
 
-    void SaveAchievementCache()
+    static std::string ItemCachePath()
     {
-        json arr = json::array();
-        {
-            std::lock_guard<std::mutex> lock(s_Mutex);
-            for (const auto& kv : s_Achievements) {
-                const auto& a = kv.second;
-                json entry;
-                entry["id"]          = a.id;
-                entry["name"]        = a.name;
-                entry["description"] = a.description;
-                entry["requirement"] = a.requirement;
-                entry["locked_text"] = a.locked_text;
-                entry["type"]        = a.type;
-                entry["icon"]        = a.icon;
-                entry["flags"]       = a.flags;
-                json bits = json::array();
-                for (const auto& b : a.bits) {
-                    json bj;
-                    bj["type"] = b.type;
-                    bj["id"]   = b.id;
-                    bj["text"] = b.text;
-                    bits.push_back(bj);
-                }
-                entry["bits"] = bits;
-                arr.push_back(entry);
-            }
-        }
-        std::ofstream(CachePath()) << arr.dump();
+        return std::string(APIDefs->Paths_GetAddonDirectory("AchievementTracker")) + "items_cache.json";
     }
 
-    void LoadAchievementCache()
+    // Progress belongs to one account, so the file is named after a fingerprint of the key
+    static std::string ProgressCachePath(const std::string& apiKey)
     {
-        std::ifstream f(CachePath());
-        if (!f.is_open()) return;
-        try {
-            json j = json::parse(f);
-            std::lock_guard<std::mutex> lock(s_Mutex);
-            for (const auto& item : j) {
-                Achievement ach;
-                ach.id          = item.value("id", 0);
-                ach.name        = item.value("name", "");
-                ach.description = item.value("description", "");
-                ach.requirement = item.value("requirement", "");
-                ach.locked_text = item.value("locked_text", "");
-                ach.type        = item.value("type", "");
-                ach.icon        = item.value("icon", "");
-                if (item.contains("flags"))
-                    for (const auto& flag : item["flags"])
-                        ach.flags.push_back(flag.get<std::string>());
-                if (item.contains("bits"))
-                    for (const auto& bit : item["bits"]) {
-                        AchievementBit b;
-                        b.type = bit.value("type", "");
-                        b.id   = bit.value("id", 0);
-                        b.text = bit.value("text", "");
-                        ach.bits.push_back(b);
-                    }
-                s_Achievements[ach.id] = ach;
-            }
-        } catch (...) {}
+        uint32_t hash = 2166136261u;  // FNV-1a
+        for (unsigned char c : apiKey) hash = (hash ^ c) * 16777619u;
+        char name[32];
+        snprintf(name, sizeof(name), "progress_%08x.json", hash);
+        return std::string(APIDefs->Paths_GetAddonDirectory("AchievementTracker")) + name;
     }
 
-    std::string HttpGet(const std::wstring& path, const std::string& apiKey)
+    bool HasAchievementCache()
     {
-        std::string result;
-        HINTERNET hSession = WinHttpOpen(L"AchievementTracker/1.0",
-            WINHTTP_ACCESS_TYPE_DEFAULT_PROXY, nullptr, nullptr, 0);
-        if (!hSession) return result;
+        return std::ifstream(CachePath()).good() || std::ifstream(LegacyCachePath()).good();
+    }
 
-        HINTERNET hConnect = WinHttpConnect(hSession,
-            L"api.guildwars2.com", INTERNET_DEFAULT_HTTPS_PORT, 0);
+    // Rebuilds the search index from the current names. Call after s_Achievements changes.
+    static void PublishNameIndex()
+    {
+        std::vector<std::pair<int, std::string>> names;
+        auto achievements = s_Achievements.Load();
+        names.reserve(achievements->Items.size());
+        for (const auto& kv : achievements->Items) names.emplace_back(kv.first, kv.second->name);
+        auto index = std::make_shared<const NameSearch::Index>(names);
+        std::lock_guard<std::mutex> lock(s_NameIndexMutex);
+        s_NameIndex = std::move(index);
+    }
 
-        HINTERNET hReq = WinHttpOpenRequest(hConnect, L"GET", path.c_str(),
-            nullptr, nullptr, nullptr, WINHTTP_FLAG_SECURE);
+    // Returns `ach` with its details decoded from the cache. Caller must hold s_Mutex
+    // or s_CacheFileMutex.
+    static std::shared_ptr<const Achievement> WithDetails(const std::shared_ptr<const Achievement>& ach)
+    {
+        if (ach->details_loaded) return ach;
+        auto full = std::make_shared<Achievement>(*ach);
+        s_CacheReader.ReadDetails(full->id, *full);
+        full->details_loaded = true;
+        return full;
+    }
 
-        if (!apiKey.empty())
+    // Decodes and publishes the details of one cache-backed entry.
+    static std::shared_ptr<const Achievement> MaterializeDetails(int id)
+    {
+        auto current = s_Achievements.Load()->FindShared(id);
+        if (!current || current->details_loaded) return current;
+        std::shared_ptr<const Achievement> full;
         {
-            std::wstring auth = L"Authorization: Bearer ";
-            auth += std::wstring(apiKey.begin(), apiKey.end());
-            WinHttpAddRequestHeaders(hReq, auth.c_str(), -1, WINHTTP_ADDREQ_FLAG_ADD);
+            Trace::Span span("cache", "DecodeDetails");
+            Metrics::TimedLock lock(s_Mutex);
+            full = WithDetails(current);
         }
+        s_Achievements.Update([&](auto& items) {
+            // Only if nobody replaced the entry meanwhile
+            auto it = items.find(id);
+            if (it != items.end() && it->second == current) it->second = full;
+        });
+        return full;
+    }
 
-        WinHttpSendRequest(hReq, nullptr, 0, nullptr, 0, 0, 0);
-        WinHttpReceiveResponse(hReq, nullptr);
-
-        DWORD bytesAvail = 0;
-        while (WinHttpQueryDataAvailable(hReq, &bytesAvail) && bytesAvail > 0)
+    // MaterializeDetails for many ids at once: one decoding pass and one table copy.
+    static void MaterializeDetails(const std::vector<int>& ids)
+    {
+        auto current = s_Achievements.Load();
+        std::vector<std::pair<std::shared_ptr<const Achievement>, std::shared_ptr<const Achievement>>> decoded;
         {
-            std::string buf(bytesAvail, '\0');
-            DWORD bytesRead = 0;
-            WinHttpReadData(hReq, buf.data(), bytesAvail, &bytesRead);
-            result.append(buf.data(), bytesRead);
+            Trace::Span span("cache", "DecodeDetails");
+            Metrics::TimedLock lock(s_Mutex);
+            for (int id : ids) {
+                auto ach = current->FindShared(id);
+                if (ach && !ach->details_loaded) decoded.emplace_back(ach, WithDetails(ach));
+            }
         }
+        if (decoded.empty()) return;
+        s_Achievements.Update([&](auto& items) {
+            for (const auto& d : decoded) {
+                auto it = items.find(d.first->id);
+                if (it != items.end() && it->second == d.first) it->second = d.second;
+            }
+        });
+    }
 
-        WinHttpCloseHandle(hReq);
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-        return result;
+    // Field-wise equality. An entry whose details still sit in the cache never
+    // equals a fetched one, which then replaces it with the same data decoded.
+    static bool SameAchievement(const Achievement& a, const Achievement& b)
+    {
+        if (!a.details_loaded || !b.details_loaded) return false;
+        if (a.id != b.id || a.type != b.type || a.flags != b.flags || a.name != b.name ||
+            a.icon != b.icon || a.description != b.description || a.requirement != b.requirement ||
+            a.locked_text != b.locked_text ||
+            a.bits.size() != b.bits.size() || a.tiers.size() != b.tiers.size())
+            return false;
+        for (size_t i = 0; i < a.bits.size(); ++i)
+            if (a.bits[i].type != b.bits[i].type || a.bits[i].id != b.bits[i].id || a.bits[i].text != b.bits[i].text)
+                return false;
+        for (size_t i = 0; i < a.tiers.size(); ++i)
+            if (a.tiers[i].count != b.tiers[i].count || a.tiers[i].points != b.tiers[i].points)
+                return false;
+        return true;
     }
 
-    void FetchAchievements(const std::vector<int>& ids) {
-        if (ids.empty()) return;
+    // Removes fetched entries identical to the current ones.
+    static void DropUnchanged(std::vector<Achievement>& fetched)
+    {
+        auto current = s_Achievements.Load();
+        fetched.erase(std::remove_if(fetched.begin(), fetched.end(), [&](const Achievement& ach) {
+            const Achievement* cur = current->Find(ach.id);
+            return cur && SameAchievement(*cur, ach);
+        }), fetched.end());
+    }
 
+    // Swaps in the fetched entries that differ from the current ones; returns
+    // whether any did. Unchanged entries keep their pointers and the generation
+    // stays put, so revalidating unchanged data rebuilds nothing downstream.
+    static bool Publish(std::vector<Achievement>& fetched)
+    {
+        return s_Achievements.UpdateIfChanged([&](auto& items) {
+            bool changed = false;
+            for (auto& ach : fetched) {
+                auto& slot = items[ach.id];
+                if (slot && SameAchievement(*slot, ach)) continue;
+                slot = std::make_shared<const Achievement>(std::move(ach));
+                changed = true;
+            }
+            return changed;
+        });
+    }
+
+    static std::string IdsPath(const char* base, const std::vector<int>& ids)
+    {
         std::stringstream ss;
+        ss << base;
         for (size_t i = 0; i < ids.size(); ++i) {
             ss << ids[i];
             if (i < ids.size() - 1) ss << ",";
         }
+        return ss.str();
+    }
 
-        std::wstring path = L"/v2/achievements?ids=";
-        std::string idsStr = ss.str();
-        path += std::wstring(idsStr.begin(), idsStr.end());
+    void SaveAchievementCache()
+    {
+        Metrics::ScopedTimer timer(MetricTimer_CacheSave);
+        Trace::Span span("cache", "SaveAchievementCache");
+        auto achievements = s_Achievements.Load();
+        // Only saves and loads move the mapping, so under s_CacheFileMutex it can be
+        // read without s_Mutex, which the render thread takes every frame
+        std::lock_guard<std::mutex> fileLock(s_CacheFileMutex);
+        // Keep lazy entries lazy: decode them into temporaries just for serializing
+        std::vector<std::shared_ptr<const Achievement>> hold;
+        std::vector<const Achievement*> all;
+        hold.reserve(achievements->Items.size());
+        all.reserve(achievements->Items.size());
+        for (const auto& kv : achievements->Items) {
+            hold.push_back(WithDetails(kv.second));
+            all.push_back(hold.back().get());
+        }
+        std::string data = AchievementCache::Serialize(s_CacheBuildId, all);
 
-        std::string response = HttpGet(path);
-        if (response.empty()) return;
+        // The mapping has to go before the file can be replaced; the new file holds
+        // every id the old one did, so lazy entries resolve against it afterwards
+        Metrics::TimedLock lock(s_Mutex);
+        s_CacheReader.Close();
+        bool written = AchievementCache::WriteFile(CachePath(), data);
+        s_CacheReader.Open(CachePath());
+        // Superseded for good; left behind, it would be read again whenever a
+        // format change makes the loader reject the binary cache
+        if (written) std::remove(LegacyCachePath().c_str());
+    }
 
+    static void LoadLegacyAchievementCache()
+    {
+        std::ifstream f(LegacyCachePath());
+        if (!f.is_open()) return;
         try {
-            json j = json::parse(response);
-            std::lock_guard<std::mutex> lock(s_Mutex);
-            for (const auto& item : j) {
+            std::string body((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+            // Caches written before build tracking are a bare array, without a build
+            uint32_t build = 0;
+            std::vector<Achievement> loaded;
+            if (!ApiJson::ParseAchievements(body, loaded, &build)) return;
+            s_CacheBuildId = build;
+            for (const auto& ach : loaded) s_TextIndex.AddAchievement(ach);
+            s_Achievements.Update([&](auto& items) {
+                // Entries fetched by the init thread in the meantime are fresher
+                for (auto& ach : loaded)
+                    if (!items.count(ach.id))
+                        items.emplace(ach.id, std::make_shared<const Achievement>(std::move(ach)));
+            });
+        } catch (...) {}
+    }
+
+    // Feeds every cached record to the search index, reading details straight
+    // from the mapping; the entries themselves only get them once displayed.
+    // Caller must hold s_CacheFileMutex.
+    static void IndexCachedAchievements()
+    {
+        Trace::Span span("cache", "IndexCachedAchievements");
+        AchievementCache::DetailsView details;
+        FullText::Document doc;
+        for (size_t i = 0; i < s_CacheReader.Count() && !s_Shutdown; ++i) {
+            int id = s_CacheReader.IdAt(i);
+            if (!s_CacheReader.ReadDetails(id, details)) continue;
+            doc.Id          = id;
+            doc.Name        = s_CacheReader.Name(id);
+            doc.Description = details.Description;
+            doc.Requirement = details.Requirement;
+            doc.BitText.clear();
+            doc.ItemIds.clear();
+            for (const auto& bit : details.Bits) {
+                if (bit.Type == BitType_Item) doc.ItemIds.push_back(bit.Id);
+                if (!bit.Text.empty()) doc.BitText.push_back(bit.Text);
+            }
+            s_TextIndex.AddDocument(doc);
+        }
+    }
+
+    void LoadAchievementCache()
+    {
+        Metrics::ScopedTimer timer(MetricTimer_CacheLoad);
+        Trace::Span span("cache", "LoadAchievementCache");
+        auto start = std::chrono::steady_clock::now();
+        // Keeps a save from replacing the file while it is read outside s_Mutex
+        std::lock_guard<std::mutex> fileLock(s_CacheFileMutex);
+        bool mapped = false;
+        {
+            Metrics::TimedLock lock(s_Mutex);
+            mapped = s_CacheReader.Open(CachePath());
+        }
+        if (mapped) {
+            s_CacheBuildId = s_CacheReader.BuildId();
+            SnapshotTable<Achievement>::Entries loaded;
+            for (size_t i = 0; i < s_CacheReader.Count(); ++i) {
+                int id = s_CacheReader.IdAt(i);
                 Achievement ach;
-                ach.id = item.value("id", 0);
-                ach.name = item.value("name", "");
-                ach.description = item.value("description", "");
-                ach.requirement = item.value("requirement", "");
-                ach.locked_text = item.value("locked_text", "");
-                ach.type = item.value("type", "");
-                ach.icon = item.value("icon", "");
-                
-                if (item.contains("flags")) {
-                    for (const auto& flag : item["flags"]) {
-                        ach.flags.push_back(flag.get<std::string>());
-                    }
-                }
+                if (!s_CacheReader.ReadSummary(id, ach)) continue;
+                ach.details_loaded = false;
+                loaded.emplace(id, std::make_shared<const Achievement>(std::move(ach)));
+            }
+            s_Achievements.Update([&](auto& items) {
+                // Entries fetched by the init thread in the meantime are fresher
+                items.merge(loaded);
+            });
+        } else {
+            LoadLegacyAchievementCache();
+        }
+        s_CacheLoadSeconds = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start).count();
+        PublishNameIndex();
+        s_CacheLoaded = true;
+        // The list is usable now; full-text matches fill in as records are indexed
+        if (mapped) IndexCachedAchievements();
+    }
 
-                if (item.contains("bits")) {
-                    for (const auto& bit : item["bits"]) {
-                        AchievementBit b;
-                        b.type = bit.value("type", "");
-                        b.id = bit.value("id", 0);
-                        b.text = bit.value("text", "");
-                        ach.bits.push_back(b);
-                    }
-                }
-                s_Achievements[ach.id] = ach;
+    // Items and progress are small and kept in the API's own format, so the same
+    // streaming readers that parse responses load them back.
+    static void SaveItemCache()
+    {
+        auto items = s_Items.Load();
+        json out = json::array();
+        for (const auto& kv : items->Items) {
+            const Item& it = *kv.second;
+            out.push_back({ { "id", it.id }, { "name", it.name }, { "description", it.description },
+                            { "type", it.type }, { "rarity", it.rarity }, { "icon", it.icon },
+                            { "chat_link", it.chat_link } });
+        }
+        std::lock_guard<std::mutex> lock(s_SaveMutex);
+        AchievementCache::WriteFile(ItemCachePath(), out.dump(-1, ' ', false, json::error_handler_t::replace));
+    }
+
+    static void SaveProgressCache(const std::string& apiKey)
+    {
+        if (apiKey.empty()) return;
+        auto progress = s_AccountAchievements.Load();
+        json out = json::array();
+        for (const auto& kv : progress->Items) {
+            const AccountAchievement& p = *kv.second;
+            out.push_back({ { "id", p.id }, { "current", p.current }, { "max", p.max },
+                            { "done", p.done }, { "bits", p.bits } });
+        }
+        std::lock_guard<std::mutex> lock(s_SaveMutex);
+        AchievementCache::WriteFile(ProgressCachePath(apiKey), out.dump());
+    }
+
+    static std::string ReadFile(const std::string& path)
+    {
+        std::ifstream f(path, std::ios::binary);
+        if (!f.is_open()) return {};
+        return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    }
+
+    static void LoadItemCache()
+    {
+        std::vector<Item> loaded;
+        if (!ApiJson::ParseItems(ReadFile(ItemCachePath()), loaded)) return;
+        s_Items.UpdateIfChanged([&](auto& items) {
+            bool changed = false;
+            for (auto& it : loaded) {
+                if (items.count(it.id)) continue;  // fetched meanwhile, so fresher
+                s_TextIndex.AddItem(it.id, it.name);
+                int id = it.id;
+                items.emplace(id, std::make_shared<const Item>(std::move(it)));
+                changed = true;
             }
-        } catch (...) {}
+            return changed;
+        });
     }
 
-    void FetchItems(const std::vector<int>& ids) {
-        if (ids.empty()) return;
+    static void LoadProgressCache(const std::string& apiKey)
+    {
+        if (apiKey.empty()) return;
+        std::vector<AccountAchievement> loaded;
+        if (!ApiJson::ParseAccountAchievements(ReadFile(ProgressCachePath(apiKey)), loaded)) return;
+        s_AccountAchievements.UpdateIfChanged([&](auto& items) {
+            bool changed = false;
+            for (auto& p : loaded) {
+                if (items.count(p.id)) continue;
+                s_ProgressFromDisk.insert(p.id);
+                int id = p.id;
+                items.emplace(id, std::make_shared<const AccountAchievement>(std::move(p)));
+                changed = true;
+            }
+            return changed;
+        });
+    }
 
-        std::stringstream ss;
-        for (size_t i = 0; i < ids.size(); ++i) {
-            ss << ids[i];
-            if (i < ids.size() - 1) ss << ",";
+    void LoadCaches(const std::vector<int>& tracked, const std::string& apiKey)
+    {
+        Trace::Span span("startup", "LoadCaches");
+        LoadAchievementCache();
+        LoadItemCache();
+        LoadProgressCache(apiKey);
+        if (!s_Shutdown) MaterializeDetails(tracked);
+    }
+
+    void RevalidateTracked(const std::vector<int>& tracked, const std::string& apiKey)
+    {
+        Trace::Span span("startup", "RevalidateTracked");
+        if (tracked.empty()) return;
+        // Everything tracked is already on screen from the cache; this only refreshes it
+        FetchAchievements(RequestLane_Background, tracked);
+
+        std::vector<int> itemIds;
+        for (int id : tracked) {
+            auto ach = GetAchievement(id);
+            if (!ach) continue;
+            for (const auto& bit : ach->bits)
+                if (bit.type == BitType_Item) itemIds.push_back(bit.id);
         }
+        std::sort(itemIds.begin(), itemIds.end());
+        itemIds.erase(std::unique(itemIds.begin(), itemIds.end()), itemIds.end());
+        if (!s_Shutdown) FetchItems(RequestLane_Background, itemIds);
 
-        std::wstring path = L"/v2/items?ids=";
-        std::string idsStr = ss.str();
-        path += std::wstring(idsStr.begin(), idsStr.end());
+        if (!s_Shutdown && !apiKey.empty()) FetchTrackedProgress(apiKey, tracked);
+    }
 
-        std::string response = HttpGet(path);
-        if (response.empty()) return;
+    double   AchievementCacheLoadSeconds() { return s_CacheLoadSeconds.load(); }
+    bool     IsAchievementCacheLoaded() { return s_CacheLoaded.load(); }
+    uint32_t AchievementCacheBuildId()  { return s_CacheBuildId.load(); }
 
-        try {
-            json j = json::parse(response);
-            std::lock_guard<std::mutex> lock(s_Mutex);
-            for (const auto& item : j) {
-                Item it;
-                it.id = item.value("id", 0);
-                it.name = item.value("name", "");
-                it.description = item.value("description", "");
-                it.type = item.value("type", "");
-                it.rarity = item.value("rarity", "");
-                it.icon = item.value("icon", "");
-                it.chat_link = item.value("chat_link", "");
-                s_Items[it.id] = it;
+    std::string HttpGet(RequestLane lane, const std::string& path, const std::string& apiKey)
+    {
+        HttpResponse resp;
+        int status = RequestScheduler::Get(lane, Http::ApiHost, path, apiKey, resp);
+        if (status < 200 || status >= 300) return {};
+        return std::move(resp.Body);
+    }
+
+    // The API takes at most this many ids per request
+    static constexpr size_t ID_BATCH = 200;
+
+    void FetchAchievements(RequestLane lane, const std::vector<int>& ids) {
+        std::vector<Achievement> parsed;
+        for (size_t first = 0; first < ids.size() && !s_Shutdown; first += ID_BATCH) {
+            std::vector<int> batch(ids.begin() + first, ids.begin() + std::min(first + ID_BATCH, ids.size()));
+            std::string response = HttpGet(lane, IdsPath("/v2/achievements?ids=", batch));
+            if (!response.empty()) ApiJson::ParseAchievements(response, parsed);
+        }
+
+        DropUnchanged(parsed);
+        if (parsed.empty()) return;
+        for (const auto& ach : parsed) s_TextIndex.AddAchievement(ach);
+        Publish(parsed);
+        PublishNameIndex();
+    }
+
+    void FetchItems(RequestLane lane, const std::vector<int>& ids) {
+        std::vector<Item> parsed;
+        for (size_t first = 0; first < ids.size() && !s_Shutdown; first += ID_BATCH) {
+            std::vector<int> batch(ids.begin() + first, ids.begin() + std::min(first + ID_BATCH, ids.size()));
+            std::string response = HttpGet(lane, IdsPath("/v2/items?ids=", batch));
+            if (!response.empty()) ApiJson::ParseItems(response, parsed);
+        }
+
+        auto current = s_Items.Load();
+        parsed.erase(std::remove_if(parsed.begin(), parsed.end(), [&](const Item& it) {
+            const Item* cur = current->Find(it.id);
+            return cur && *cur == it;
+        }), parsed.end());
+        if (parsed.empty()) return;
+
+        for (const auto& it : parsed) s_TextIndex.AddItem(it.id, it.name);
+        s_Items.Update([&](auto& items) {
+            for (auto& it : parsed) {
+                int id = it.id;
+                items[id] = std::make_shared<const Item>(std::move(it));
             }
-        } catch (...) {}
+        });
+        SaveItemCache();
     }
 
     void FetchAccountAchievements(const std::string& apiKey) {
         if (apiKey.empty()) return;
 
-        std::string response = HttpGet(L"/v2/account/achievements", apiKey);
+        std::string response = HttpGet(RequestLane_Progress, "/v2/account/achievements", apiKey);
         if (response.empty()) return;
 
-        try {
-            json j = json::parse(response);
-            std::lock_guard<std::mutex> lock(s_Mutex);
-            for (const auto& item : j) {
-                AccountAchievement ach;
-                ach.id = item.value("id", 0);
-                ach.current = item.value("current", 0);
-                ach.max = item.value("max", 0);
-                ach.done = item.value("done", false);
-                
-                if (item.contains("bits")) {
-                    for (const auto& bit : item["bits"]) {
-                        ach.bits.push_back(bit.get<int>());
-                    }
-                }
-                s_AccountAchievements[ach.id] = ach;
-            }
-        } catch (...) {}
+        std::vector<AccountAchievement> parsed;
+        if (!ApiJson::ParseAccountAchievements(response, parsed)) return;
+        // The endpoint returns the whole account, so the new table replaces the old one
+        SnapshotTable<AccountAchievement>::Entries progress;
+        for (auto& ach : parsed) {
+            int id = ach.id;
+            progress[id] = std::make_shared<const AccountAchievement>(std::move(ach));
+        }
+        s_AccountAchievements.Replace(std::move(progress));
+        SaveProgressCache(apiKey);
+    }
+
+    // Highest tier whose threshold `current` has reached, 1-based; 0 for none.
+    static int TierOf(const Achievement* ach, int current)
+    {
+        int tier = 0;
+        if (ach)
+            for (const auto& t : ach->tiers)
+                if (current >= t.count) ++tier;
+        return tier;
     }
 
-    const Achievement* GetAchievement(int id) {
-        std::lock_guard<std::mutex> lock(s_Mutex);
-        auto it = s_Achievements.find(id);
-        if (it != s_Achievements.end()) {
-            return &it->second;
+    static bool Diff(const AccountAchievement& before, const AccountAchievement& after,
+                     const Achievement* ach, ProgressEvent& ev)
+    {
+        ev.Id      = after.id;
+        ev.Current = after.current;
+        ev.Max     = after.max;
+        if (after.done && !before.done) {
+            ev.Type = ProgressEvent::Kind_Completed;
+            return true;
+        }
+        int tier = TierOf(ach, after.current);
+        if (tier > TierOf(ach, before.current)) {
+            ev.Type  = ProgressEvent::Kind_TierReached;
+            ev.Count = tier;
+            return true;
         }
-        return nullptr;
+        int newBits = 0;
+        for (int bit : after.bits)
+            if (std::find(before.bits.begin(), before.bits.end(), bit) == before.bits.end()) ++newBits;
+        if (newBits > 0) {
+            ev.Type  = ProgressEvent::Kind_BitsCompleted;
+            ev.Count = newBits;
+            return true;
+        }
+        return false;
     }
 
-    const Item* GetItem(int id) {
-        std::lock_guard<std::mutex> lock(s_Mutex);
-        auto it = s_Items.find(id);
-        if (it != s_Items.end()) {
-            return &it->second;
+    void FetchTrackedProgress(const std::string& apiKey, const std::vector<int>& ids) {
+        if (apiKey.empty() || ids.empty()) return;
+
+        std::vector<int> requested;
+        std::vector<AccountAchievement> parsed;
+        HttpResponse resp;
+        for (size_t first = 0; first < ids.size() && !s_Shutdown; first += ID_BATCH) {
+            std::vector<int> batch(ids.begin() + first, ids.begin() + std::min(first + ID_BATCH, ids.size()));
+            RequestScheduler::Get(RequestLane_Progress, Http::ApiHost,
+                                  IdsPath("/v2/account/achievements?ids=", batch), apiKey, resp);
+            // Ids without progress are left out (206), or all of them are (404)
+            if (resp.Status == 404) {
+                requested.insert(requested.end(), batch.begin(), batch.end());
+            } else if ((resp.Status == 200 || resp.Status == 206) &&
+                       ApiJson::ParseAccountAchievements(resp.Body, parsed)) {
+                requested.insert(requested.end(), batch.begin(), batch.end());
+            }
         }
-        return nullptr;
+        if (requested.empty()) return;
+
+        std::unordered_map<int, AccountAchievement*> byId;
+        for (auto& p : parsed) byId[p.id] = &p;
+        auto achievements = s_Achievements.Load();
+        std::vector<ProgressEvent> events;
+        const AccountAchievement none{};
+        bool changed = false;
+
+        s_AccountAchievements.UpdateIfChanged([&](auto& items) {
+            for (int id : requested) {
+                auto old   = items.find(id);
+                auto fresh = byId.find(id);
+                // Progress made while the addon was not running is no news
+                bool fromDisk = s_ProgressFromDisk.erase(id) > 0;
+                bool baseline = !fromDisk && (old != items.end() || s_ProgressSeen.count(id));
+                s_ProgressSeen.insert(id);
+
+                if (fresh == byId.end()) {
+                    if (old != items.end()) { items.erase(old); changed = true; }
+                    continue;
+                }
+                const AccountAchievement& after = *fresh->second;
+                // Unchanged entries keep their pointer, so views built on them stay valid
+                if (old != items.end() && *old->second == after) continue;
+
+                ProgressEvent ev;
+                if (baseline && Diff(old != items.end() ? *old->second : none, after,
+                                     achievements->Find(id), ev))
+                    events.push_back(ev);
+                items[id] = std::make_shared<const AccountAchievement>(std::move(*fresh->second));
+                changed = true;
+            }
+            return changed;
+        });
+        if (changed) SaveProgressCache(apiKey);
+
+        Metrics::TimedLock lock(s_Mutex);
+        s_ProgressEvents.insert(s_ProgressEvents.end(), events.begin(), events.end());
+        ++s_ProgressSync.Fetches;
+        s_ProgressSync.LastChanged = changed;
+    }
+
+    ProgressSyncCounters ProgressSyncStatus() {
+        Metrics::TimedLock lock(s_Mutex);
+        return s_ProgressSync;
+    }
+
+    std::vector<ProgressEvent> TakeProgressEvents() {
+        Metrics::TimedLock lock(s_Mutex);
+        std::vector<ProgressEvent> events;
+        events.swap(s_ProgressEvents);
+        return events;
+    }
+
+    Snapshot AcquireSnapshot() {
+        return { s_Achievements.Load(), s_Items.Load(), s_AccountAchievements.Load() };
     }
 
-    const AccountAchievement* GetAccountAchievement(int id) {
-        std::lock_guard<std::mutex> lock(s_Mutex);
-        auto it = s_AccountAchievements.find(id);
-        if (it != s_AccountAchievements.end()) {
-            return &it->second;
+    std::shared_ptr<const Achievement> GetAchievement(int id) {
+        return MaterializeDetails(id);
+    }
+
+    std::shared_ptr<const Item> GetItem(int id) {
+        return s_Items.Load()->FindShared(id);
+    }
+
+    std::shared_ptr<const AccountAchievement> GetAccountAchievement(int id) {
+        return s_AccountAchievements.Load()->FindShared(id);
+    }
+
+    // Decodes queued details in batches until the queue runs dry.
+    static void DetailsWorker()
+    {
+        Trace::SetThreadName("Details");
+        for (;;) {
+            std::vector<int> ids;
+            {
+                Metrics::TimedLock lock(s_Mutex);
+                if (s_DetailsQueue.empty() || s_Shutdown) {
+                    for (int id : s_DetailsQueue) s_PendingDetails.erase(id);
+                    s_DetailsQueue.clear();
+                    s_DetailsWorker = false;
+                    return;
+                }
+                ids.swap(s_DetailsQueue);
+            }
+            MaterializeDetails(ids);
+            Metrics::TimedLock lock(s_Mutex);
+            for (int id : ids) s_PendingDetails.erase(id);
         }
-        return nullptr;
+    }
+
+    void RequestDetailsAsync(int id) {
+        if (s_Shutdown) return;
+        Metrics::TimedLock lock(s_Mutex);
+        if (!s_PendingDetails.insert(id).second) return;
+        s_DetailsQueue.push_back(id);
+        if (s_DetailsWorker) return;
+        s_DetailsWorker = true;
+        std::thread(DetailsWorker).detach();
     }
 
     bool IsLoadingAllAchievements() { return s_LoadingAll.load(); }
+    bool IsPrefetchingItems()       { return s_PrefetchingItems.load(); }
+
+    // Item ids referenced by any catalog bit that have no entry, sorted and unique.
+    // Lazy entries are read from the cache mapping rather than materialized.
+    static std::vector<int> MissingItemIds()
+    {
+        auto achievements = s_Achievements.Load();
+        auto items        = s_Items.Load();
+        std::vector<int> ids;
+        AchievementCache::DetailsView details;
+        for (const auto& kv : achievements->Items) {
+            const Achievement& ach = *kv.second;
+            if (ach.details_loaded) {
+                for (const auto& bit : ach.bits)
+                    if (bit.type == BitType_Item && !items->Find(bit.id)) ids.push_back(bit.id);
+                continue;
+            }
+            Metrics::TimedLock lock(s_Mutex);
+            if (!s_CacheReader.ReadDetails(ach.id, details)) continue;
+            for (const auto& bit : details.Bits)
+                if (bit.Type == BitType_Item && !items->Find(bit.Id)) ids.push_back(bit.Id);
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+
+    void PrefetchItemsAsync() {
+        if (s_PrefetchingItems.exchange(true)) return;
+        std::thread([]() {
+            Trace::SetThreadName("ItemPrefetch");
+            Trace::Span span("sync", "PrefetchItems");
+            std::vector<int> ids = MissingItemIds();
+            bool fetched = false;
+            for (size_t first = 0; first < ids.size() && !s_Shutdown; first += ID_BATCH) {
+                std::vector<int> batch(ids.begin() + first, ids.begin() + std::min(first + ID_BATCH, ids.size()));
+                std::string response = HttpGet(RequestLane_Background, IdsPath("/v2/items?ids=", batch));
+                std::vector<Item> parsed;
+                if (response.empty() || !ApiJson::ParseItems(response, parsed)) continue;
+                // Published per batch so names show up while the rest is on its way
+                fetched |= s_Items.UpdateIfChanged([&](auto& items) {
+                    bool changed = false;
+                    for (auto& it : parsed) {
+                        if (items.count(it.id)) continue;  // fetched by FetchItems meanwhile
+                        s_TextIndex.AddItem(it.id, it.name);
+                        int id = it.id;
+                        items.emplace(id, std::make_shared<const Item>(std::move(it)));
+                        changed = true;
+                    }
+                    return changed;
+                });
+            }
+            if (fetched) SaveItemCache();
+            s_PrefetchingItems = false;
+        }).detach();
+    }
 
     int CachedAchievementCount() {
-        std::lock_guard<std::mutex> lock(s_Mutex);
-        return static_cast<int>(s_Achievements.size());
+        return static_cast<int>(s_Achievements.Load()->Items.size());
     }
 
-    void FetchAllAchievementsAsync() {
+    CatalogMemory CatalogMemoryUsage() {
+        auto achievements = s_Achievements.Load();
+        {
+            std::lock_guard<std::mutex> lock(s_MemoryMutex);
+            if (s_MemoryGeneration == achievements->Generation) return s_Memory;
+        }
+        CatalogMemory mem;
+        for (const auto& kv : achievements->Items) {
+            const Achievement& a = *kv.second;
+            // Map node, control block and record, plus what the record owns
+            mem.Entries += 4 * sizeof(void*) + sizeof(kv) + 2 * sizeof(void*) + sizeof(Achievement);
+            if (a.name.capacity() > 15) mem.Entries += a.name.capacity() + 1;  // past the SSO buffer
+            mem.Entries += a.bits.capacity() * sizeof(AchievementBit);
+            mem.Entries += a.tiers.capacity() * sizeof(AchievementTier);
+        }
+        mem.Strings = StringPool::Bytes();
+        std::lock_guard<std::mutex> lock(s_MemoryMutex);
+        s_Memory           = mem;
+        s_MemoryGeneration = achievements->Generation;
+        return mem;
+    }
+
+    CatalogSync::Stats LastCatalogSyncStats() {
+        Metrics::TimedLock lock(s_Mutex);
+        return s_LastSyncStats;
+    }
+
+    // Picks which ids to download. A full sync takes everything; an incremental one
+    // takes ids missing from the cache plus a random revalidation sample, and drops
+    // cached entries the API no longer lists.
+    static std::vector<int> PlanCatalogSync(const std::vector<int>& allIds, bool incremental)
+    {
+        if (!incremental) return allIds;
+
+        std::unordered_set<int> listed(allIds.begin(), allIds.end());
+        std::vector<int> toFetch, known;
+        // Only a sync that actually drops entries publishes a new table version
+        s_Achievements.UpdateIfChanged([&](auto& items) {
+            size_t retired = 0;
+            for (const auto& kv : items) retired += !listed.count(kv.first);
+            // A list that drops more than a few percent of the catalog is far more
+            // likely broken than the game retiring that much; keep everything then
+            bool dropRetired = retired <= (size_t)(items.size() * MAX_RETIRED_SHARE);
+            for (auto it = items.begin(); it != items.end(); ) {
+                if (!listed.count(it->first)) {
+                    if (dropRetired) {
+                        s_TextIndex.Remove(it->first);
+                        it = items.erase(it);
+                    } else {
+                        ++it;
+                    }
+                    continue;
+                }
+                known.push_back(it->first);
+                ++it;
+            }
+            for (int id : allIds)
+                if (!items.count(id)) toFetch.push_back(id);
+            return dropRetired && retired > 0;
+        });
+
+        std::mt19937 rng(std::random_device{}());
+        std::sample(known.begin(), known.end(), std::back_inserter(toFetch),
+                    std::min(REVALIDATE_SAMPLE, known.size()), rng);
+        return toFetch;
+    }
+
+    static void SyncCatalogAsync(bool incremental, int maxInFlight) {
         if (s_LoadingAll.exchange(true)) return;
-        std::thread([]() {
+        std::thread([incremental, maxInFlight]() {
+            Trace::SetThreadName("CatalogSync");
+            Trace::Span span("sync", incremental ? "RefreshCatalog" : "DownloadCatalog");
             if (s_Shutdown) { s_LoadingAll = false; return; }
 
-            std::string resp = HttpGet(L"/v2/achievements");
+            std::string resp = HttpGet(RequestLane_Background, "/v2/achievements");
             if (resp.empty() || s_Shutdown) { s_LoadingAll = false; return; }
             std::vector<int> allIds;
-            try {
-                auto j = nlohmann::json::parse(resp);
-                for (auto& v : j) allIds.push_back(v.get<int>());
-            } catch (...) { s_LoadingAll = false; return; }
-
-            const int BATCH = 200;
-            for (size_t i = 0; i < allIds.size(); i += BATCH) {
-                if (s_Shutdown) break;
-                std::vector<int> batch(allIds.begin() + i,
-                    allIds.begin() + std::min(i + BATCH, allIds.size()));
-                FetchAchievements(batch);
+            // An empty list would plan the whole catalog away
+            if (!ApiJson::ParseIds(resp, allIds) || allIds.empty()) { s_LoadingAll = false; return; }
+
+            CatalogSync::Options opts;
+            opts.MaxInFlight = maxInFlight;
+            std::vector<Achievement> fetched;
+            CatalogSync::Stats stats = CatalogSync::Run(PlanCatalogSync(allIds, incremental), opts,
+                [](const std::vector<int>& batch, std::string& body) {
+                    HttpResponse resp;
+                    resp.Body.swap(body);
+                    RequestScheduler::Get(RequestLane_Background, Http::ApiHost,
+                                          IdsPath("/v2/achievements?ids=", batch), "", resp);
+                    resp.Body.swap(body);
+                    // 206 means some ids of the batch no longer exist; the rest are there
+                    return resp.Status == 200 || resp.Status == 206;
+                },
+                [](const std::string& body, std::vector<Achievement>& out) {
+                    size_t first = out.size();
+                    ApiJson::ParseAchievements(body, out);
+                    for (size_t i = first; i < out.size(); ++i) s_TextIndex.AddAchievement(out[i]);
+                },
+                fetched, s_Shutdown);
+
+            Publish(fetched);
+            {
+                Metrics::TimedLock lock(s_Mutex);
+                s_LastSyncStats = stats;
             }
+            PublishNameIndex();
 
+            if (!s_Shutdown && stats.FailedBatches == 0) {
+                uint32_t build = MumbleLink ? MumbleLink->Context.BuildId : 0;
+                if (build != 0) s_CacheBuildId = build;
+            }
             if (!s_Shutdown) SaveAchievementCache();
+            // New achievements bring new item references; started first, so the
+            // prefetch is already flagged when the sync is seen as over
+            if (!s_Shutdown) PrefetchItemsAsync();
             s_LoadingAll = false;
         }).detach();
     }
 
-    std::vector<Achievement> SearchAchievements(const std::string& query) {
-        std::string lower = query;
-        std::transform(lower.begin(), lower.end(), lower.begin(),
-            [](unsigned char c){ return std::tolower(c); });
-
-        std::lock_guard<std::mutex> lock(s_Mutex);
-        std::vector<Achievement> results;
-        for (const auto& kv : s_Achievements) {
-            std::string name = kv.second.name;
-            std::transform(name.begin(), name.end(), name.begin(),
-                [](unsigned char c){ return std::tolower(c); });
-            if (name.find(lower) != std::string::npos) {
-                results.push_back(kv.second);
-                if (results.size() >= 50) break;
+    void FetchCategoryTreeAsync() {
+        if (s_LoadingCategoryTree.exchange(true)) return;
+        std::thread([]() {
+            Trace::SetThreadName("CategoryTree");
+            Trace::Span span("sync", "FetchCategoryTree");
+            auto tree = std::make_shared<CategoryTree>();
+            std::vector<AchievementCategory> categories;
+            std::vector<AchievementGroup>    groups;
+            if (!ApiJson::ParseCategories(HttpGet(RequestLane_User, "/v2/achievements/categories?ids=all"), categories) ||
+                !ApiJson::ParseGroups(HttpGet(RequestLane_User, "/v2/achievements/groups?ids=all"), groups) ||
+                s_Shutdown)
+            {
+                s_LoadingCategoryTree = false;
+                return;
             }
+
+            for (auto& cat : categories) {
+                int id = cat.id;
+                tree->Categories.emplace(id, std::move(cat));
+            }
+            auto byOrder = [&](int a, int b) {
+                return tree->Categories.at(a).order < tree->Categories.at(b).order;
+            };
+            for (auto& group : groups) {
+                auto& ids = group.categories;
+                ids.erase(std::remove_if(ids.begin(), ids.end(), [&](int id) {
+                    return !tree->Categories.count(id);
+                }), ids.end());
+                std::stable_sort(ids.begin(), ids.end(), byOrder);
+            }
+            std::stable_sort(groups.begin(), groups.end(), [](const AchievementGroup& a, const AchievementGroup& b) {
+                return a.order < b.order;
+            });
+            tree->Groups = std::move(groups);
+            {
+                std::lock_guard<std::mutex> lock(s_CategoryMutex);
+                s_CategoryTree = std::move(tree);
+            }
+            s_LoadingCategoryTree = false;
+        }).detach();
+    }
+
+    bool IsLoadingCategoryTree() { return s_LoadingCategoryTree.load(); }
+
+    std::shared_ptr<const CategoryTree> GetCategoryTree() {
+        std::lock_guard<std::mutex> lock(s_CategoryMutex);
+        return s_CategoryTree;
+    }
+
+    void LoadCategoryAsync(int categoryId) {
+        auto tree = GetCategoryTree();
+        const AchievementCategory* cat = tree ? tree->FindCategory(categoryId) : nullptr;
+        if (!cat) return;
+
+        // Entries backed by the cache count as loaded; their details decode on display
+        std::vector<int> missing;
+        auto achievements = s_Achievements.Load();
+        for (int id : cat->achievements)
+            if (!achievements->Find(id)) missing.push_back(id);
+        if (missing.empty()) return;
+        {
+            std::lock_guard<std::mutex> lock(s_CategoryMutex);
+            if (!s_LoadingCategories.insert(categoryId).second) return;
+        }
+        std::thread([categoryId, missing = std::move(missing)]() {
+            Trace::SetThreadName("Category");
+            Trace::Span span("sync", "LoadCategory");
+            if (!s_Shutdown) FetchAchievements(RequestLane_User, missing);
+            if (!s_Shutdown) PrefetchItemsAsync();
+            std::lock_guard<std::mutex> lock(s_CategoryMutex);
+            s_LoadingCategories.erase(categoryId);
+        }).detach();
+    }
+
+    bool IsCategoryLoading(int categoryId) {
+        std::lock_guard<std::mutex> lock(s_CategoryMutex);
+        return s_LoadingCategories.count(categoryId) != 0;
+    }
+
+    void FetchAllAchievementsAsync(int maxInFlight) { SyncCatalogAsync(false, maxInFlight); }
+    void RefreshAchievementsAsync(int maxInFlight)  { SyncCatalogAsync(true,  maxInFlight); }
+
+    // Flat score added when the whole query appears verbatim in a name
+    static constexpr float PHRASE_BOOST       = 20.0f;
+    static constexpr float PHRASE_START_BOOST = 10.0f;
+    static constexpr float EXACT_NAME_BOOST   = 20.0f;
+
+    NameSearch::Results SearchAchievements(const std::string& query, size_t limit,
+                                           const SearchRequest& req) {
+        std::string folded;
+        NameSearch::Fold(query, folded);
+
+        std::shared_ptr<const NameSearch::Index> index;
+        {
+            std::lock_guard<std::mutex> lock(s_NameIndexMutex);
+            index = s_NameIndex;
+        }
+        if (!index) return {};
+
+        std::unordered_map<int, float> boosts;
+        auto boostRow = [&](uint32_t row) {
+            std::string_view name = index->FoldedName(row);
+            float boost = PHRASE_BOOST;
+            if (name.compare(0, folded.size(), folded) == 0) boost += PHRASE_START_BOOST;
+            if (name.size() == folded.size())                boost += EXACT_NAME_BOOST;
+            boosts[index->Id(row)] = boost;
+        };
+        // A narrowed query extends the previous one, so every name containing it was
+        // already among the previous matches; the name index finds them directly.
+        for (uint32_t row : index->Find(folded, index->Size())) boostRow(row);
+
+        FullText::QueryOptions opts;
+        opts.Boosts  = &boosts;
+        opts.Within  = req.Within;
+        opts.Matched = req.Matched;
+        opts.Cancel  = req.Cancel;
+        std::vector<uint32_t> rows;
+        for (const auto& hit : s_TextIndex.Query(query, limit, opts)) {
+            int row = index->RowOf(hit.Id);
+            if (row >= 0) rows.push_back((uint32_t)row);
         }
-        return results;
+        return NameSearch::Results(std::move(index), std::move(rows));
     }
 
+    uint64_t SearchGeneration() { return s_TextIndex.Generation(); }
+
     void FetchAndTrack(int id) {
         std::thread([id]() {
+            Trace::SetThreadName("FetchAndTrack");
+            Trace::Span span("sync", "FetchAndTrack");
             if (s_Shutdown) return;
-            FetchAchievements({id});
+            FetchAchievements(RequestLane_User, {id});
             if (s_Shutdown) return;
-            const Achievement* ach = GetAchievement(id);
+            auto ach = GetAchievement(id);
             if (ach) {
                 std::vector<int> itemIds;
                 for (const auto& bit : ach->bits)
-                    if (bit.type == "Item") itemIds.push_back(bit.id);
-                if (!itemIds.empty()) FetchItems(itemIds);
+                    if (bit.type == BitType_Item) itemIds.push_back(bit.id);
+                if (!itemIds.empty()) FetchItems(RequestLane_User, itemIds);
             }
-            if (!s_Shutdown) LoadTextures();
         }).detach();
     }
 
-    static bool DownloadIconToDisk(const std::wstring& urlPath, const std::string& localPath)
+    static std::string DownloadIcon(const std::string& url, const std::string& urlPath,
+                                    const std::string& filename)
     {
-        HINTERNET hSession = WinHttpOpen(L"AchievementTracker/1.0",
-            WINHTTP_ACCESS_TYPE_DEFAULT_PROXY, nullptr, nullptr, 0);
-        if (!hSession) return false;
-
-        HINTERNET hConnect = WinHttpConnect(hSession,
-            L"render.guildwars2.com", INTERNET_DEFAULT_HTTPS_PORT, 0);
-        HINTERNET hReq = WinHttpOpenRequest(hConnect, L"GET", urlPath.c_str(),
-            nullptr, nullptr, nullptr, WINHTTP_FLAG_SECURE);
-
-        bool ok = false;
-        if (hReq &&
-            WinHttpSendRequest(hReq, nullptr, 0, nullptr, 0, 0, 0) &&
-            WinHttpReceiveResponse(hReq, nullptr))
-        {
-            DWORD status = 0, sz = sizeof(status);
-            WinHttpQueryHeaders(hReq,
-                WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
-                nullptr, &status, &sz, nullptr);
-            if (status == 200)
-            {
-                std::ofstream ofs(localPath, std::ios::binary);
-                DWORD avail = 0;
-                while (WinHttpQueryDataAvailable(hReq, &avail) && avail > 0)
-                {
-                    std::string buf(avail, '\0');
-                    DWORD read = 0;
-                    WinHttpReadData(hReq, buf.data(), avail, &read);
-                    ofs.write(buf.data(), read);
-                }
-                ok = ofs.good();
-            }
-        }
-        if (hReq)     WinHttpCloseHandle(hReq);
-        if (hConnect) WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-        return ok;
+        HttpResponse resp;
+        RequestScheduler::Get(RequestLane_Icon, Http::RenderHost, urlPath, "", resp);
+        if (resp.Status != 200 || resp.Body.empty()) return {};
+        return IconCache::Store(filename, url, resp.Body);
     }
 
-    static const std::string& IconsDir()
+    bool LoadIcon(const std::string& url, const std::string& texName)
     {
-        static std::string dir;
-        if (dir.empty()) {
-            dir = std::string(APIDefs->Paths_GetAddonDirectory("AchievementTracker")) + "icons\\";
-            CreateDirectoryA(dir.c_str(), nullptr);
-        }
-        return dir;
-    }
-
-    static void EnsureIconCached(const std::string& url, const std::string& texName)
-    {
-        if (s_Shutdown || !APIDefs) return;
-        if (APIDefs->Textures_Get(texName.c_str())) return;
+        if (s_Shutdown || !APIDefs) return false;
+        if (APIDefs->Textures_Get(texName.c_str())) return true;
 
         size_t pos = url.find("render.guildwars2.com");
-        if (pos == std::string::npos) return;
+        if (pos == std::string::npos) return false;
         std::string urlPath = url.substr(pos + 21);
 
         size_t slash = urlPath.rfind('/');
         std::string filename = (slash != std::string::npos) ? urlPath.substr(slash + 1) : urlPath;
-        std::string localPath = IconsDir() + filename;
 
-        if (std::ifstream(localPath, std::ios::binary).good()) {
-            APIDefs->Textures_LoadFromFile(texName.c_str(), localPath.c_str(), nullptr);
-            return;
-        }
+        std::string localPath = IconCache::Lookup(filename);
+        if (localPath.empty()) localPath = DownloadIcon(url, urlPath, filename);
+        if (localPath.empty()) return false;
+        Trace::Span span("texture", "LoadFromFile", filename);
+        APIDefs->Textures_LoadFromFile(texName.c_str(), localPath.c_str(), nullptr);
+        return true;
+    }
 
-        std::wstring wPath(urlPath.begin(), urlPath.end());
-        if (DownloadIconToDisk(wPath, localPath))
-            APIDefs->Textures_LoadFromFile(texName.c_str(), localPath.c_str(), nullptr);
+    void FetchTrackedProgressAsync(const std::string& apiKey, const std::vector<int>& ids) {
+        if (apiKey.empty() || ids.empty()) return;
+        std::thread([apiKey, ids]() {
+            Trace::SetThreadName("Progress");
+            Trace::Span span("sync", "FetchTrackedProgress");
+            if (!s_Shutdown) FetchTrackedProgress(apiKey, ids);
+        }).detach();
     }
 
     void FetchAccountAchievementsAsync(const std::string& apiKey) {
         if (apiKey.empty()) return;
         std::thread([apiKey]() {
+            Trace::SetThreadName("AccountProgress");
+            Trace::Span span("sync", "FetchAccountAchievements");
             if (!s_Shutdown) FetchAccountAchievements(apiKey);
         }).detach();
     }
-
-    void RequestIconAsync(const std::string& url, const std::string& texName) {
-        if (url.empty() || texName.empty() || s_Shutdown) return;
-        // Skip if already loaded
-        if (APIDefs && APIDefs->Textures_Get(texName.c_str())) return;
-        {
-            std::lock_guard<std::mutex> lock(s_Mutex);
-            if (s_QueuedIcons.count(texName)) return;
-            s_QueuedIcons.insert(texName);
-        }
-        std::thread([url, texName]() {
-            if (!s_Shutdown) EnsureIconCached(url, texName);
-        }).detach();
-    }
-
-    void LoadTextures() {
-        std::vector<std::pair<std::string,std::string>> achIcons, itemIcons;
-        {
-            std::lock_guard<std::mutex> lock(s_Mutex);
-            for (const auto& pair : s_Achievements)
-                if (!pair.second.icon.empty())
-                    achIcons.push_back({"ACHIEVEMENT_ICON_" + std::to_string(pair.first), pair.second.icon});
-            for (const auto& pair : s_Items)
-                if (!pair.second.icon.empty())
-                    itemIcons.push_back({"ITEM_ICON_" + std::to_string(pair.first), pair.second.icon});
-        }
-        for (const auto& kv : achIcons)  EnsureIconCached(kv.second, kv.first);
-        for (const auto& kv : itemIcons) EnsureIconCached(kv.second, kv.first);
-    }
 }
@@ -1,25 +1,76 @@
 #pragma once
+#include "CatalogSync.h"
+#include "NameSearch.h"
+#include "RequestScheduler.h"
+#include "SnapshotStore.h"
+#include "StringPool.h"
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <memory>
 #include <nlohmann/json.hpp>
 
+enum AchievementType : uint8_t {
+    AchievementType_Default,
+    AchievementType_ItemSet,
+};
+
+// Bit flags of Achievement::flags, one per API flag string.
+enum AchievementFlags_ : uint32_t {
+    AchievementFlags_Pvp                  = 1u << 0,
+    AchievementFlags_CategoryDisplay      = 1u << 1,
+    AchievementFlags_MoveToTop            = 1u << 2,
+    AchievementFlags_IgnoreNearlyComplete = 1u << 3,
+    AchievementFlags_Repeatable           = 1u << 4,
+    AchievementFlags_Hidden               = 1u << 5,
+    AchievementFlags_RequiresUnlock       = 1u << 6,
+    AchievementFlags_RepairOnLogin        = 1u << 7,
+    AchievementFlags_Daily                = 1u << 8,
+    AchievementFlags_Weekly               = 1u << 9,
+    AchievementFlags_Monthly              = 1u << 10,
+    AchievementFlags_Permanent            = 1u << 11,
+};
+
+enum BitType : uint8_t {
+    BitType_Text,
+    BitType_Item,
+    BitType_Minipet,
+    BitType_Skin,
+    BitType_Unknown,
+};
+
+AchievementType ParseAchievementType(std::string_view s);
+uint32_t        ParseAchievementFlag(std::string_view s);  // 0 for unknown flags
+BitType         ParseBitType(std::string_view s);
+
+struct AchievementTier {
+    int count  = 0;  // progress needed to reach the tier
+    int points = 0;
+};
+
 struct AchievementBit {
-    std::string type;
-    int id = 0;
-    std::string text;
+    BitType      type = BitType_Text;
+    int          id   = 0;
+    PooledString text;
 };
 
+// Free text is pooled: descriptions, requirements and bit texts repeat a lot
+// across the catalog (tiers, collections, daily variants).
 struct Achievement {
-    int id;
-    std::string name;
-    std::string description;
-    std::string requirement;
-    std::string locked_text;
-    std::string type;
-    std::vector<std::string> flags;
-    std::vector<AchievementBit> bits;
-    std::string icon;
+    int             id      = 0;
+    AchievementType type    = AchievementType_Default;
+    bool            details_loaded = true;  // false while description/requirement/bits still sit in the binary cache
+    uint32_t        flags   = 0;            // AchievementFlags_
+    std::string     name;
+    PooledString    icon;
+    PooledString    description;
+    PooledString    requirement;
+    PooledString    locked_text;
+    std::vector<AchievementBit>  bits;
+    std::vector<AchievementTier> tiers;
 };
 
 struct Item {
@@ -30,6 +81,29 @@ struct Item {
     std::string rarity;
     std::string icon;
     std::string chat_link;
+
+    bool operator==(const Item& o) const
+    {
+        return id == o.id && name == o.name && description == o.description && type == o.type &&
+               rarity == o.rarity && icon == o.icon && chat_link == o.chat_link;
+    }
+};
+
+// The browse tree the game's own achievement panel shows: groups ("Story
+// Journal", "Collections", ...) of categories, each listing achievement ids.
+struct AchievementCategory {
+    int              id    = 0;
+    int              order = 0;
+    std::string      name;
+    std::string      icon;
+    std::vector<int> achievements;
+};
+
+struct AchievementGroup {
+    std::string      id;  // a GUID
+    int              order = 0;
+    std::string      name;
+    std::vector<int> categories;  // sorted by the categories' order once in a CategoryTree
 };
 
 struct AccountAchievement {
@@ -38,37 +112,153 @@ struct AccountAchievement {
     int max;
     bool done;
     std::vector<int> bits;
+
+    bool operator==(const AccountAchievement& o) const
+    {
+        return id == o.id && current == o.current && max == o.max && done == o.done && bits == o.bits;
+    }
+};
+
+// Something worth telling the player about, found by diffing tracked progress.
+// At most one per achievement and fetch, the most significant one.
+struct ProgressEvent {
+    enum Kind : uint8_t {
+        Kind_BitsCompleted,  // Count = bits newly done
+        Kind_TierReached,    // Count = tier now reached, 1-based
+        Kind_Completed,
+    };
+    Kind Type    = Kind_BitsCompleted;
+    int  Id      = 0;
+    int  Count   = 0;
+    int  Current = 0;
+    int  Max     = 0;
 };
 
 namespace GW2Api {
-    std::string HttpGet(const std::wstring& path, const std::string& apiKey = "");
+    // Body of a successful (2xx) response through the request scheduler, else "".
+    std::string HttpGet(RequestLane lane, const std::string& path, const std::string& apiKey = "");
 
-    void FetchAchievements(const std::vector<int>& ids);
-    void FetchItems(const std::vector<int>& ids);
+    // Both fetch in batches of 200 ids on `lane` and swap in only entries that differ
+    // from the current ones, so revalidating unchanged data leaves the tables alone.
+    void FetchAchievements(RequestLane lane, const std::vector<int>& ids);
+    void FetchItems(RequestLane lane, const std::vector<int>& ids);
+    // Downloads the account's whole progress list and replaces the table.
     void FetchAccountAchievements(const std::string& apiKey);
+    // Fetches progress for `ids` only, in ?ids= batches, updating just the entries
+    // that changed and queueing a ProgressEvent for each tracked milestone.
+    void FetchTrackedProgress(const std::string& apiKey, const std::vector<int>& ids);
+    // Events found since the last call, oldest first.
+    std::vector<ProgressEvent> TakeProgressEvents();
 
-    void FetchAllAchievementsAsync();
+    struct ProgressSyncCounters {
+        uint64_t Fetches     = 0;      // completed FetchTrackedProgress calls
+        bool     LastChanged = false;  // whether the latest one changed any entry
+    };
+    ProgressSyncCounters ProgressSyncStatus();
+
+    // Downloads the full catalog with up to `maxInFlight` batch requests outstanding.
+    void FetchAllAchievementsAsync(int maxInFlight = 4);
+    // Fetches only ids missing from the cache plus a small revalidation sample.
+    void RefreshAchievementsAsync(int maxInFlight = 4);
     bool IsLoadingAllAchievements();
     int  CachedAchievementCount();
+    CatalogSync::Stats LastCatalogSyncStats();
+
+    // Groups in display order; categories by id. Only category ids in `Categories`
+    // are listed in the groups.
+    struct CategoryTree {
+        std::vector<AchievementGroup>            Groups;
+        std::map<int, AchievementCategory>       Categories;
 
-    const Achievement* GetAchievement(int id);
-    const Item*        GetItem(int id);
-    const AccountAchievement* GetAccountAchievement(int id);
+        const AchievementCategory* FindCategory(int id) const
+        {
+            auto it = Categories.find(id);
+            return it != Categories.end() ? &it->second : nullptr;
+        }
+    };
+    // Fetches all groups and categories, two small requests; GetCategoryTree is
+    // null until they are in.
+    void FetchCategoryTreeAsync();
+    bool IsLoadingCategoryTree();
+    std::shared_ptr<const CategoryTree> GetCategoryTree();
+    // Fetches the category's achievements that are not in the store yet, in
+    // 200-id batches on the user lane, then their items. A no-op while the
+    // category is already loading.
+    void LoadCategoryAsync(int categoryId);
+    bool IsCategoryLoading(int categoryId);
 
-    std::vector<Achievement> SearchAchievements(const std::string& query);
+    // Fetches, on the background lane, every item any catalog achievement's bits
+    // point at that has no entry yet, so collections show item names without a
+    // request of their own. Saves the item cache once done.
+    void PrefetchItemsAsync();
+    bool IsPrefetchingItems();
+
+    struct CatalogMemory {
+        size_t Entries = 0;  // achievement records, names and bit arrays
+        size_t Strings = 0;  // shared pool of descriptions, requirements and bit texts
+    };
+    // Approximate heap held by the loaded catalog. Recounted only after the
+    // achievement table changes, so it is cheap enough to call every frame.
+    CatalogMemory CatalogMemoryUsage();
+
+    // One consistent view of all data that never waits for a writer. The render thread takes one per
+    // frame; pointers from it stay valid for as long as the snapshot is held.
+    struct Snapshot {
+        std::shared_ptr<const SnapshotTable<Achievement>::Version>        Achievements;
+        std::shared_ptr<const SnapshotTable<Item>::Version>               Items;
+        std::shared_ptr<const SnapshotTable<AccountAchievement>::Version> Progress;
+
+        const Achievement*        FindAchievement(int id) const { return Achievements->Find(id); }
+        const Item*               FindItem(int id)        const { return Items->Find(id); }
+        const AccountAchievement* FindProgress(int id)    const { return Progress->Find(id); }
+    };
+    Snapshot AcquireSnapshot();
+
+    // Decodes a cache-backed achievement's details in the background (see details_loaded).
+    void RequestDetailsAsync(int id);
+
+    // Worker-thread lookups; GetAchievement decodes missing details synchronously.
+    std::shared_ptr<const Achievement>        GetAchievement(int id);
+    std::shared_ptr<const Item>               GetItem(int id);
+    std::shared_ptr<const AccountAchievement> GetAccountAchievement(int id);
+
+    struct SearchRequest {
+        const std::vector<int>*  Within  = nullptr;  // previous matches of a query this one extends
+        std::vector<int>*        Matched = nullptr;  // receives every qualifying id, not just the top `limit`
+        const std::atomic<bool>* Cancel  = nullptr;
+    };
+
+    // Ranked search over names, descriptions, requirements, bit text and linked
+    // item names; names containing the whole query rank first. Does not take s_Mutex.
+    NameSearch::Results SearchAchievements(const std::string& query, size_t limit = 50,
+                                           const SearchRequest& req = {});
+    // Changes whenever searchable data does; candidate sets from another generation are stale.
+    uint64_t SearchGeneration();
 
-    void LoadTextures();
     void FetchAndTrack(int id);
 
     void FetchAccountAchievementsAsync(const std::string& apiKey);
+    void FetchTrackedProgressAsync(const std::string& apiKey, const std::vector<int>& ids);
 
-    // Triggers an async download+load of a single icon if not already queued/loaded.
-    // Safe to call every frame; internally de-duplicates requests.
-    void RequestIconAsync(const std::string& url, const std::string& texName);
+    // Blocking: loads an icon from the disk cache, downloading it first if needed,
+    // and registers it as texture `texName`; false if the icon could not be had.
+    // Run by the IconPipeline workers.
+    bool LoadIcon(const std::string& url, const std::string& texName);
 
     void Shutdown();
 
+    // Startup, from disk: the catalog cache, cached items and the account's last
+    // known progress, with the tracked achievements' details decoded up front so
+    // the first frame can show them whole. Never overwrites fresher entries.
+    void LoadCaches(const std::vector<int>& tracked, const std::string& apiKey);
+    // Startup, over the network: re-fetches the tracked achievements, their items
+    // and progress, swapping in only what changed since the caches were written.
+    void RevalidateTracked(const std::vector<int>& tracked, const std::string& apiKey);
+
     void LoadAchievementCache();
     void SaveAchievementCache();
     bool HasAchievementCache();
+    bool IsAchievementCacheLoaded();
+    uint32_t AchievementCacheBuildId();
+    double   AchievementCacheLoadSeconds();
 }
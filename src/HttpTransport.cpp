@@ -0,0 +1,20 @@
+#include "HttpTransport.h"
+#include <mutex>
+
+namespace Http {
+
+    static std::mutex                     s_TransportMutex;
+    static std::shared_ptr<HttpTransport> s_Transport;
+
+    void SetTransport(std::shared_ptr<HttpTransport> transport)
+    {
+        std::lock_guard<std::mutex> lock(s_TransportMutex);
+        s_Transport = std::move(transport);
+    }
+
+    std::shared_ptr<HttpTransport> GetTransport()
+    {
+        std::lock_guard<std::mutex> lock(s_TransportMutex);
+        return s_Transport;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct HttpResponse {
+    int         Status     = 0;   // 0 when no response was received at all
+    int         RetryAfter = 0;   // seconds from a Retry-After header; 0 if absent
+    std::string Body;
+};
+
+struct HttpTransportStats {
+    uint64_t Requests          = 0;
+    uint64_t ConnectionsOpened = 0;   // requests sent on a new connection: TCP + TLS handshake
+    uint64_t ConnectionsReused = 0;   // requests sent on a kept-alive one
+};
+
+// Blocking HTTPS GET against a fixed set of hosts. Implementations keep
+// connections alive between calls and must be safe to call from any thread.
+class HttpTransport {
+public:
+    virtual ~HttpTransport() = default;
+
+    // `host` is a bare host name ("api.guildwars2.com"), `path` includes the query string.
+    // Fills `resp` in place so callers can reuse its Body allocation; returns the status.
+    virtual int Get(const std::string& host, const std::string& path,
+                    const std::string& bearerToken, HttpResponse& resp) = 0;
+
+    HttpResponse Get(const std::string& host, const std::string& path,
+                     const std::string& bearerToken = "")
+    {
+        HttpResponse resp;
+        Get(host, path, bearerToken, resp);
+        return resp;
+    }
+    virtual HttpTransportStats Stats() const = 0;
+};
+
+namespace Http {
+    constexpr const char* ApiHost    = "api.guildwars2.com";
+    constexpr const char* RenderHost = "render.guildwars2.com";
+
+    // Pooled WinHTTP transport: one session per host, at most `maxConnectionsPerHost`
+    // keep-alive connections each. Only available in the Windows build.
+    std::shared_ptr<HttpTransport> CreateWinHttpTransport(int maxConnectionsPerHost);
+
+    void                           SetTransport(std::shared_ptr<HttpTransport> transport);
+    std::shared_ptr<HttpTransport> GetTransport();
+}
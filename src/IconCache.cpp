@@ -0,0 +1,203 @@
+#include "IconCache.h"
+#include "Trace.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+namespace IconCache {
+
+    static constexpr const char* MANIFEST = "manifest.json";
+    // Saving on every store would rewrite the manifest once per icon on a cold cache
+    static constexpr int SAVE_EVERY = 32;
+
+    struct Entry {
+        uint64_t    Size    = 0;
+        int64_t     LastUse = 0;  // unix milliseconds
+        std::string Url;
+    };
+
+    static std::mutex                             s_Mutex;
+    static bool                                   s_Open = false;
+    static std::string                            s_Dir;
+    static std::unordered_map<std::string, Entry> s_Entries;  // by file name
+    static uint64_t                               s_Bytes  = 0;
+    static uint64_t                               s_Budget = 0;
+    static uint64_t                               s_Hits = 0, s_Misses = 0, s_Evictions = 0;
+    static int                                    s_Unsaved = 0;
+
+    static int64_t Now()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static bool WriteAtomic(const std::string& path, const char* data, size_t size)
+    {
+        Trace::Span span("cache", "WriteFile", fs::path(path).filename().string());
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+            f.write(data, (std::streamsize)size);
+            if (!f.good()) return false;
+        }
+        std::error_code ec;
+        fs::rename(tmp, path, ec);
+        if (!ec) return true;
+        fs::remove(tmp, ec);  // a successful remove clears ec, so it cannot be the result
+        return false;
+    }
+
+    // Caller holds s_Mutex.
+    static void SaveManifest()
+    {
+        json j = json::object();
+        for (const auto& kv : s_Entries)
+            j[kv.first] = { { "size", kv.second.Size }, { "used", kv.second.LastUse }, { "url", kv.second.Url } };
+        std::string text = j.dump();
+        WriteAtomic(s_Dir + MANIFEST, text.data(), text.size());
+        s_Unsaved = 0;
+    }
+
+    // Caller holds s_Mutex.
+    static void Evict(const std::string& keep)
+    {
+        if (s_Budget == 0 || s_Bytes <= s_Budget) return;
+        std::vector<std::pair<int64_t, std::string>> byAge;
+        byAge.reserve(s_Entries.size());
+        for (const auto& kv : s_Entries)
+            if (kv.first != keep) byAge.push_back({ kv.second.LastUse, kv.first });
+        std::sort(byAge.begin(), byAge.end());
+
+        std::error_code ec;
+        for (const auto& victim : byAge) {
+            if (s_Bytes <= s_Budget) break;
+            fs::remove(s_Dir + victim.second, ec);
+            s_Bytes -= s_Entries[victim.second].Size;
+            s_Entries.erase(victim.second);
+            ++s_Evictions;
+            ++s_Unsaved;
+        }
+    }
+
+    void Open(const std::string& dir, uint64_t budgetBytes)
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        if (s_Open) return;
+        s_Open   = true;
+        s_Dir    = dir;
+        s_Budget = budgetBytes;
+        s_Entries.clear();
+        s_Bytes  = 0;
+
+        std::ifstream f(s_Dir + MANIFEST);
+        if (f.is_open()) {
+            try {
+                json j = json::parse(f);
+                for (auto it = j.begin(); it != j.end(); ++it) {
+                    Entry e;
+                    e.Size    = it.value().value("size", (uint64_t)0);
+                    e.LastUse = it.value().value("used", (int64_t)0);
+                    e.Url     = it.value().value("url", "");
+                    s_Entries.emplace(it.key(), std::move(e));
+                }
+            } catch (...) { s_Entries.clear(); }
+        }
+
+        // Reconcile with the directory: drop entries whose file is gone, adopt icons
+        // written before the manifest existed, and delete leftover partial downloads
+        std::unordered_map<std::string, Entry> onDisk;
+        std::error_code ec;
+        int64_t now = Now();
+        for (fs::directory_iterator it(s_Dir, ec), end; !ec && it != end; it.increment(ec)) {
+            if (!it->is_regular_file(ec)) continue;
+            std::string name = it->path().filename().string();
+            if (name == MANIFEST) continue;
+            if (it->path().extension() == ".tmp") { fs::remove(it->path(), ec); continue; }
+            auto known = s_Entries.find(name);
+            Entry e = known != s_Entries.end() ? known->second : Entry{ 0, now, "" };
+            e.Size = it->file_size(ec);
+            s_Bytes += e.Size;
+            onDisk.emplace(name, std::move(e));
+        }
+        if (onDisk.size() != s_Entries.size()) s_Unsaved = 1;
+        s_Entries.swap(onDisk);
+        Evict("");
+    }
+
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        if (!s_Open) return;
+        if (s_Unsaved) SaveManifest();
+        s_Open = false;
+    }
+
+    void SetBudget(uint64_t budgetBytes)
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        s_Budget = budgetBytes;
+    }
+
+    void Trim()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        if (s_Open) Evict("");
+    }
+
+    std::string Lookup(const std::string& filename)
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        auto it = s_Entries.find(filename);
+        if (!s_Open || it == s_Entries.end()) { ++s_Misses; return {}; }
+        ++s_Hits;
+        it->second.LastUse = Now();
+        ++s_Unsaved;
+        return s_Dir + filename;
+    }
+
+    std::string Store(const std::string& filename, const std::string& url, const std::string& data)
+    {
+        if (filename.empty() || data.empty()) return {};
+        // The write happens outside the lock; concurrent stores of one file are
+        // prevented upstream by the icon pipeline never loading a texture twice
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            if (!s_Open) return {};
+            path = s_Dir + filename;
+        }
+        if (!WriteAtomic(path, data.data(), data.size())) return {};
+
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        Entry& e = s_Entries[filename];
+        s_Bytes -= e.Size;
+        e.Size    = data.size();
+        e.LastUse = Now();
+        e.Url     = url;
+        s_Bytes  += e.Size;
+        Evict(filename);
+        if (++s_Unsaved >= SAVE_EVERY) SaveManifest();
+        return path;
+    }
+
+    Stats GetStats()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        Stats s;
+        s.Files     = s_Entries.size();
+        s.Bytes     = s_Bytes;
+        s.Budget    = s_Budget;
+        s.Hits      = s_Hits;
+        s.Misses    = s_Misses;
+        s.Evictions = s_Evictions;
+        return s;
+    }
+}
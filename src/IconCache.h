@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// On-disk icon store with a manifest (size, last use, source URL per file)
+// loaded once at startup, so lookups never touch the filesystem. Files are
+// written to a temp name and renamed into place, so a partial download is never
+// picked up as a texture. Least recently used files are evicted once the store
+// grows past its byte budget. Thread-safe.
+namespace IconCache {
+
+    struct Stats {
+        size_t   Files     = 0;
+        uint64_t Bytes     = 0;
+        uint64_t Budget    = 0;
+        uint64_t Hits      = 0;
+        uint64_t Misses    = 0;
+        uint64_t Evictions = 0;
+    };
+
+    // `dir` must end with a path separator.
+    void Open(const std::string& dir, uint64_t budgetBytes);
+    // Writes the manifest if anything changed since it was last saved.
+    void Close();
+    // Takes effect at the next Store or Trim; no file is deleted here.
+    void SetBudget(uint64_t budgetBytes);
+    // Evicts down to the budget. Deletes files, so keep it off the render thread.
+    void Trim();
+
+    // Local path of a cached file, marking it used; empty on a miss.
+    std::string Lookup(const std::string& filename);
+    // Stores downloaded bytes and returns the local path, or empty on failure.
+    std::string Store(const std::string& filename, const std::string& url, const std::string& data);
+
+    Stats GetStats();
+}
@@ -0,0 +1,198 @@
+#include "IconPipeline.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace IconPipeline {
+
+    using Clock = std::chrono::steady_clock;
+
+    // A queued icon survives this many frames without being requested again
+    static constexpr uint64_t STALE_FRAMES = 2;
+    // A failed icon can be requested again after this long
+    static constexpr std::chrono::seconds RETRY_AFTER{ 30 };
+
+    struct Pending {
+        std::string       Url;
+        uint64_t          Frame    = 0;  // last frame that asked for it
+        uint32_t          Order    = 0;  // position in that frame; lower loads first
+        Clock::time_point Enqueued;
+    };
+
+    static std::mutex                               s_Mutex;
+    static std::condition_variable                  s_Cv;
+    static std::vector<std::thread>                 s_Workers;
+    static bool                                     s_Running = false;
+    static LoadFn                                   s_Load    = nullptr;
+    static std::unordered_map<std::string, Pending> s_Queue;   // by texName
+    static std::unordered_set<std::string>          s_Started; // in flight or loaded, never requeued
+    static std::unordered_map<std::string, Clock::time_point> s_FailedAt;  // by texName, until retried
+    static std::vector<TaskFn>                      s_Tasks;   // run before any icon
+    static uint64_t                                 s_Frame   = 0;
+    static uint32_t                                 s_Order   = 0;
+
+    static size_t            s_InFlight  = 0;
+    static size_t            s_Loaded    = 0;
+    static size_t            s_Cancelled = 0;
+    static size_t            s_Failed    = 0;
+    static double            s_LatencySum = 0.0;
+    static double            s_FirstIconMs = 0.0;
+    static bool              s_BurstOpen  = false;
+    static Clock::time_point s_BurstStart;
+
+    static double MsSince(Clock::time_point t)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+    }
+
+    static void Worker()
+    {
+        Trace::SetThreadName("IconWorker");
+        std::unique_lock<std::mutex> lock(s_Mutex);
+        for (;;) {
+            s_Cv.wait(lock, []() { return !s_Running || !s_Queue.empty() || !s_Tasks.empty(); });
+            if (!s_Running) break;
+
+            if (!s_Tasks.empty()) {
+                TaskFn task = s_Tasks.front();
+                s_Tasks.erase(s_Tasks.begin());
+                lock.unlock();
+                task();
+                lock.lock();
+                continue;
+            }
+
+            // Highest priority: requested most recently, then earliest in its frame
+            auto best = s_Queue.end();
+            for (auto it = s_Queue.begin(); it != s_Queue.end(); ++it) {
+                if (best == s_Queue.end() ||
+                    it->second.Frame > best->second.Frame ||
+                    (it->second.Frame == best->second.Frame && it->second.Order < best->second.Order))
+                    best = it;
+            }
+            std::string texName = best->first;
+            Pending     job     = std::move(best->second);
+            s_Queue.erase(best);
+            s_Started.insert(texName);
+            ++s_InFlight;
+            lock.unlock();
+
+            bool loaded = s_Load(job.Url, texName);
+
+            lock.lock();
+            --s_InFlight;
+            if (!loaded) {
+                // Not started after all, so a later request tries again
+                s_Started.erase(texName);
+                s_FailedAt[texName] = Clock::now();
+                ++s_Failed;
+                continue;
+            }
+            ++s_Loaded;
+            s_LatencySum += MsSince(job.Enqueued);
+            if (s_BurstOpen) {
+                s_FirstIconMs = MsSince(s_BurstStart);
+                s_BurstOpen   = false;
+            }
+        }
+    }
+
+    void Start(int workers, LoadFn load)
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        if (s_Running || !load) return;
+        s_Running = true;
+        s_Load    = load;
+        for (int i = 0; i < workers; ++i) s_Workers.emplace_back(Worker);
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            if (!s_Running) return;
+            s_Running = false;
+            s_Queue.clear();
+            s_Tasks.clear();
+        }
+        s_Cv.notify_all();
+        for (auto& t : s_Workers) t.join();
+        s_Workers.clear();
+        s_Started.clear();
+        s_FailedAt.clear();
+    }
+
+    void BeginFrame()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        ++s_Frame;
+        s_Order = 0;
+        for (auto it = s_Queue.begin(); it != s_Queue.end(); ) {
+            if (s_Frame - it->second.Frame > STALE_FRAMES) {
+                it = s_Queue.erase(it);
+                ++s_Cancelled;
+            } else {
+                ++it;
+            }
+        }
+        Metrics::SetGauge(MetricGauge_IconQueue, (int64_t)s_Queue.size());
+    }
+
+    void Request(const std::string& url, const std::string& texName)
+    {
+        if (url.empty() || texName.empty()) return;
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            if (!s_Running || s_Started.count(texName)) return;
+            auto failed = s_FailedAt.find(texName);
+            if (failed != s_FailedAt.end()) {
+                if (Clock::now() - failed->second < RETRY_AFTER) return;
+                s_FailedAt.erase(failed);
+            }
+            auto ins = s_Queue.try_emplace(texName);
+            Pending& p = ins.first->second;
+            p.Frame = s_Frame;
+            p.Order = s_Order++;
+            if (!ins.second) return;
+            Metrics::SetGauge(MetricGauge_IconQueue, (int64_t)s_Queue.size());
+            p.Url      = url;
+            p.Enqueued = Clock::now();
+            if (!s_BurstOpen && s_InFlight == 0 && s_Queue.size() == 1) {
+                s_BurstOpen  = true;
+                s_BurstStart = p.Enqueued;
+            }
+        }
+        s_Cv.notify_one();
+    }
+
+    void Post(TaskFn task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            if (!s_Running || !task) return;
+            s_Tasks.push_back(task);
+        }
+        s_Cv.notify_one();
+    }
+
+    Stats GetStats()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        Stats s;
+        s.Workers      = (int)s_Workers.size();
+        s.Queued       = s_Queue.size();
+        s.InFlight     = s_InFlight;
+        s.Loaded       = s_Loaded;
+        s.Cancelled    = s_Cancelled;
+        s.Failed       = s_Failed;
+        s.FirstIconMs  = s_FirstIconMs;
+        s.AvgLatencyMs = s_Loaded ? s_LatencySum / (double)s_Loaded : 0.0;
+        return s;
+    }
+}
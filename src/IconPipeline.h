@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+
+// Bounded icon loader driven by what the tracker window shows. The render thread
+// opens each frame with BeginFrame and calls Request for every icon that is on
+// screen but not loaded yet, top to bottom; earlier requests are served first.
+// Queued icons that stop being requested (scrolled away, collapsed, untracked)
+// are dropped before a worker gets to them.
+namespace IconPipeline {
+
+    // Downloads (or reads from disk) one icon and registers it as `texName`;
+    // false if there is no texture to show for it.
+    using LoadFn = bool (*)(const std::string& url, const std::string& texName);
+    // Maintenance to run on a worker, ahead of any queued icon.
+    using TaskFn = void (*)();
+
+    struct Stats {
+        int    Workers    = 0;
+        size_t Queued     = 0;
+        size_t InFlight   = 0;
+        size_t Loaded     = 0;
+        size_t Cancelled  = 0;
+        size_t Failed     = 0;
+        double FirstIconMs = 0.0;  // idle queue -> first icon of the burst loaded
+        double AvgLatencyMs = 0.0; // request -> loaded, over all icons so far
+    };
+
+    void Start(int workers, LoadFn load);
+    void Stop();
+
+    void BeginFrame();
+    void Request(const std::string& url, const std::string& texName);
+    // Queues `task` for the next free worker; dropped if the pipeline is stopped.
+    void Post(TaskFn task);
+
+    Stats GetStats();
+}
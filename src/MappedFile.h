@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. Empty files and failures leave it closed.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool        IsOpen() const { return m_Data != nullptr; }
+    const char* Data()   const { return m_Data; }
+    size_t      Size()   const { return m_Size; }
+
+private:
+    const char* m_Data = nullptr;
+    size_t      m_Size = 0;
+#ifdef _WIN32
+    void*       m_File    = nullptr;
+    void*       m_Mapping = nullptr;
+#endif
+};
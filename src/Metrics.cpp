@@ -0,0 +1,176 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace Metrics {
+
+    static constexpr auto COLLECT_INTERVAL = std::chrono::milliseconds(250);
+
+    static constexpr const char* COUNTER_NAMES[MetricCounter_Count] = {
+        "http_requests", "http_bytes", "http_errors",
+    };
+    static constexpr const char* TIMER_NAMES[MetricTimer_Count] = {
+        "frame", "http_achievements", "http_items", "http_account", "http_icons", "http_other",
+        "parse", "cache_load", "cache_save", "mutex_wait",
+    };
+    static constexpr const char* GAUGE_NAMES[MetricGauge_Count] = {
+        "icon_queue",
+    };
+
+    using Cell = std::atomic<uint64_t>;
+
+    struct TimerShard {
+        Cell Count{0}, TotalNs{0}, MaxNs{0};
+        Cell Buckets[BUCKETS] = {};
+    };
+
+    // Written only by its own thread; other threads just read it
+    struct alignas(64) Shard {
+        Cell       Counters[MetricCounter_Count] = {};
+        TimerShard Timers[MetricTimer_Count];
+    };
+
+    static std::mutex                 s_Mutex;
+    static std::vector<Shard*>        s_Shards;
+    static Snapshot                   s_Retired;   // totals of threads that have exited
+    static Snapshot                   s_Last;
+    static std::chrono::steady_clock::time_point s_LastCollect;
+    static std::atomic<int64_t>       s_Gauges[MetricGauge_Count]     = {};
+    static std::atomic<int64_t>       s_GaugePeaks[MetricGauge_Count] = {};
+
+    static void Fold(const Shard& shard, Snapshot& into)
+    {
+        for (int c = 0; c < MetricCounter_Count; ++c)
+            into.Counters[c] += shard.Counters[c].load(std::memory_order_relaxed);
+        for (int t = 0; t < MetricTimer_Count; ++t) {
+            const TimerShard& src = shard.Timers[t];
+            TimerStats&       dst = into.Timers[t];
+            dst.Count   += src.Count.load(std::memory_order_relaxed);
+            dst.TotalNs += src.TotalNs.load(std::memory_order_relaxed);
+            dst.MaxNs    = std::max(dst.MaxNs, src.MaxNs.load(std::memory_order_relaxed));
+            for (int b = 0; b < BUCKETS; ++b) dst.Buckets[b] += src.Buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+
+    struct ShardOwner {
+        Shard* Local = new Shard();
+        ShardOwner()
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_Shards.push_back(Local);
+        }
+        ~ShardOwner()
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            Fold(*Local, s_Retired);
+            s_Shards.erase(std::find(s_Shards.begin(), s_Shards.end(), Local));
+            delete Local;
+        }
+    };
+
+    static Shard& LocalShard()
+    {
+        thread_local ShardOwner owner;
+        return *owner.Local;
+    }
+
+    // Single writer per cell, so a plain load + store is enough and avoids a locked add
+    static inline void Bump(Cell& cell, uint64_t n)
+    {
+        cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static int BucketOf(uint64_t ns)
+    {
+        uint64_t us = ns / 1000;
+        int b = 0;
+        while (us > 0 && b < BUCKETS - 1) { us >>= 1; ++b; }
+        return b;
+    }
+
+    void Add(MetricCounter counter, uint64_t n)
+    {
+        Bump(LocalShard().Counters[counter], n);
+    }
+
+    void Record(MetricTimer timer, uint64_t ns)
+    {
+        TimerShard& t = LocalShard().Timers[timer];
+        Bump(t.Count, 1);
+        Bump(t.TotalNs, ns);
+        Bump(t.Buckets[BucketOf(ns)], 1);
+        if (ns > t.MaxNs.load(std::memory_order_relaxed)) t.MaxNs.store(ns, std::memory_order_relaxed);
+    }
+
+    void SetGauge(MetricGauge gauge, int64_t value)
+    {
+        s_Gauges[gauge].store(value, std::memory_order_relaxed);
+        int64_t peak = s_GaugePeaks[gauge].load(std::memory_order_relaxed);
+        while (value > peak && !s_GaugePeaks[gauge].compare_exchange_weak(peak, value, std::memory_order_relaxed)) {}
+    }
+
+    double TimerStats::PercentileMs(double p) const
+    {
+        if (Count == 0) return 0.0;
+        uint64_t target = (uint64_t)std::ceil(p * (double)Count);
+        uint64_t seen   = 0;
+        for (int b = 0; b < BUCKETS - 1; ++b) {
+            seen += Buckets[b];
+            if (seen >= target) return std::min((double)(1ull << b) / 1000.0, MaxNs / 1e6);
+        }
+        return MaxNs / 1e6;
+    }
+
+    Snapshot Collect()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        auto now = std::chrono::steady_clock::now();
+        if (now - s_LastCollect < COLLECT_INTERVAL) return s_Last;
+
+        Snapshot snap = s_Retired;
+        for (const Shard* shard : s_Shards) Fold(*shard, snap);
+        for (int g = 0; g < MetricGauge_Count; ++g) {
+            snap.Gauges[g]     = s_Gauges[g].load(std::memory_order_relaxed);
+            snap.GaugePeaks[g] = s_GaugePeaks[g].load(std::memory_order_relaxed);
+        }
+        s_Last        = snap;
+        s_LastCollect = now;
+        return snap;
+    }
+
+    bool Dump(const std::string& path)
+    {
+        Snapshot snap = Collect();
+        json j;
+        for (int c = 0; c < MetricCounter_Count; ++c) j["counters"][COUNTER_NAMES[c]] = snap.Counters[c];
+        for (int g = 0; g < MetricGauge_Count; ++g)
+            j["gauges"][GAUGE_NAMES[g]] = { { "value", snap.Gauges[g] }, { "peak", snap.GaugePeaks[g] } };
+        for (int t = 0; t < MetricTimer_Count; ++t) {
+            const TimerStats& s = snap.Timers[t];
+            json buckets = json::array();
+            for (int b = 0; b < BUCKETS; ++b) buckets.push_back(s.Buckets[b]);
+            j["timers"][TIMER_NAMES[t]] = {
+                { "count",  s.Count },
+                { "avg_ms", s.AvgMs() },
+                { "p50_ms", s.PercentileMs(0.50) },
+                { "p95_ms", s.PercentileMs(0.95) },
+                { "p99_ms", s.PercentileMs(0.99) },
+                { "max_ms", s.MaxNs / 1e6 },
+                { "buckets_log2_us", buckets },
+            };
+        }
+        std::ofstream f(path, std::ios::trunc);
+        f << j.dump(2);
+        return f.good();
+    }
+
+    const char* Name(MetricCounter counter) { return COUNTER_NAMES[counter]; }
+    const char* Name(MetricTimer timer)     { return TIMER_NAMES[timer]; }
+    const char* Name(MetricGauge gauge)     { return GAUGE_NAMES[gauge]; }
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+enum MetricCounter : uint8_t {
+    MetricCounter_HttpRequests,
+    MetricCounter_HttpBytes,
+    MetricCounter_HttpErrors,    // no response or a non-2xx status
+    MetricCounter_Count
+};
+
+enum MetricTimer : uint8_t {
+    MetricTimer_Frame,           // UI::Render
+    MetricTimer_HttpAchievements,
+    MetricTimer_HttpItems,
+    MetricTimer_HttpAccount,
+    MetricTimer_HttpIcons,
+    MetricTimer_HttpOther,
+    MetricTimer_Parse,           // one API response body
+    MetricTimer_CacheLoad,
+    MetricTimer_CacheSave,
+    MetricTimer_MutexWait,       // GW2Api's shared mutex, contended acquisitions only
+    MetricTimer_Count
+};
+
+enum MetricGauge : uint8_t {
+    MetricGauge_IconQueue,
+    MetricGauge_Count
+};
+
+// Always-on counters and latency histograms. Each thread records into its own
+// shard with plain relaxed stores (no locked instructions, no shared cache
+// lines); Collect sums the shards, at most a few times per second.
+namespace Metrics {
+
+    // Log2 buckets over microseconds: bucket 0 is < 1 us, bucket i is [2^(i-1), 2^i) us
+    constexpr int BUCKETS = 26;
+
+    struct TimerStats {
+        uint64_t Count   = 0;
+        uint64_t TotalNs = 0;
+        uint64_t MaxNs   = 0;
+        uint64_t Buckets[BUCKETS] = {};
+
+        double AvgMs() const { return Count ? TotalNs / 1e6 / Count : 0.0; }
+        // Upper bound of the bucket holding the p-th percentile (p in 0..1).
+        double PercentileMs(double p) const;
+    };
+
+    struct Snapshot {
+        uint64_t   Counters[MetricCounter_Count] = {};
+        TimerStats Timers[MetricTimer_Count];
+        int64_t    Gauges[MetricGauge_Count]     = {};
+        int64_t    GaugePeaks[MetricGauge_Count] = {};
+    };
+
+    void Add(MetricCounter counter, uint64_t n = 1);
+    void Record(MetricTimer timer, uint64_t ns);
+    void SetGauge(MetricGauge gauge, int64_t value);
+
+    // Sums every thread's shard; reuses the previous result if it is fresh enough.
+    Snapshot Collect();
+    // Writes the current totals as JSON; false if the file could not be written.
+    bool Dump(const std::string& path);
+
+    const char* Name(MetricCounter counter);
+    const char* Name(MetricTimer timer);
+    const char* Name(MetricGauge gauge);
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(MetricTimer timer)
+            : m_Timer(timer), m_Start(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer()
+        {
+            Record(m_Timer, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_Start).count());
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        MetricTimer                           m_Timer;
+        std::chrono::steady_clock::time_point m_Start;
+    };
+
+    // lock_guard that records how long it waited when the mutex was already taken.
+    // The uncontended path is a single try_lock.
+    class TimedLock {
+    public:
+        explicit TimedLock(std::mutex& m) : m_Mutex(m)
+        {
+            if (m_Mutex.try_lock()) return;
+            auto start = std::chrono::steady_clock::now();
+            m_Mutex.lock();
+            Record(MetricTimer_MutexWait, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count());
+        }
+        ~TimedLock() { m_Mutex.unlock(); }
+        TimedLock(const TimedLock&) = delete;
+        TimedLock& operator=(const TimedLock&) = delete;
+
+    private:
+        std::mutex& m_Mutex;
+    };
+}
@@ -0,0 +1,135 @@
+#include "NameSearch.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define NAMESEARCH_SSE2 1
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace NameSearch {
+
+    static constexpr size_t npos = (size_t)-1;
+
+    void Fold(std::string_view in, std::string& out)
+    {
+        out.clear();
+        out.reserve(in.size());
+        for (size_t i = 0; i < in.size(); ++i) {
+            unsigned char c = (unsigned char)in[i];
+            if (c >= 'A' && c <= 'Z') {
+                out += (char)(c + 32);
+            } else if (c == 0xC3 && i + 1 < in.size()) {
+                // U+00C0..U+00DE (except U+00D7 '×') lowercase to U+00E0..U+00FE
+                unsigned char c2 = (unsigned char)in[i + 1];
+                if (c2 >= 0x80 && c2 <= 0x9E && c2 != 0x97) c2 += 0x20;
+                out += (char)c;
+                out += (char)c2;
+                ++i;
+            } else if (c == 0xE2 && i + 2 < in.size() &&
+                       (unsigned char)in[i + 1] == 0x80 &&
+                       ((unsigned char)in[i + 2] == 0x98 || (unsigned char)in[i + 2] == 0x99)) {
+                out += '\'';
+                i += 2;
+            } else {
+                out += (char)c;
+            }
+        }
+    }
+
+#ifdef NAMESEARCH_SSE2
+    static inline unsigned LowestBit(unsigned mask)
+    {
+#ifdef _MSC_VER
+        unsigned long idx;
+        _BitScanForward(&idx, mask);
+        return (unsigned)idx;
+#else
+        return (unsigned)__builtin_ctz(mask);
+#endif
+    }
+#endif
+
+    // First offset >= `from` where `needle` occurs in `hay`, or npos. The SSE2 path
+    // compares the needle's first and last byte against 16 candidate starts at once
+    // and only runs memcmp on positions where both match.
+    static size_t FindNext(const char* hay, size_t hayLen, size_t from,
+                           const char* needle, size_t n)
+    {
+        if (n == 0 || hayLen < n) return npos;
+        const size_t last = hayLen - n;
+        size_t i = from;
+
+#ifdef NAMESEARCH_SSE2
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i final = _mm_set1_epi8(needle[n - 1]);
+        for (; i + 15 <= last; i += 16) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + n - 1));
+            unsigned mask = (unsigned)_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, final)));
+            while (mask) {
+                unsigned bit = LowestBit(mask);
+                if (n <= 2 || std::memcmp(hay + i + bit + 1, needle + 1, n - 2) == 0)
+                    return i + bit;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; i <= last; ++i)
+            if (hay[i] == needle[0] && std::memcmp(hay + i, needle, n) == 0)
+                return i;
+        return npos;
+    }
+
+    Index::Index(const std::vector<std::pair<int, std::string>>& entries)
+    {
+        m_Ids.reserve(entries.size());
+        m_FoldedOffsets.reserve(entries.size() + 1);
+        m_NameOffsets.reserve(entries.size());
+
+        std::string folded;
+        for (const auto& e : entries) {
+            m_Ids.push_back(e.first);
+
+            m_NameOffsets.push_back((uint32_t)m_Names.size());
+            m_Names += e.second;
+            m_Names += '\0';
+
+            Fold(e.second, folded);
+            m_FoldedOffsets.push_back((uint32_t)m_Folded.size());
+            m_Folded += folded;
+            m_Folded += '\0';
+        }
+        m_FoldedOffsets.push_back((uint32_t)m_Folded.size());
+    }
+
+    int Index::RowOf(int id) const
+    {
+        auto it = std::lower_bound(m_Ids.begin(), m_Ids.end(), id);
+        return (it != m_Ids.end() && *it == id) ? (int)(it - m_Ids.begin()) : -1;
+    }
+
+    std::vector<uint32_t> Index::Find(std::string_view foldedQuery, size_t limit) const
+    {
+        std::vector<uint32_t> rows;
+        if (foldedQuery.empty() || m_Ids.empty()) return rows;
+
+        size_t pos = 0;
+        while (rows.size() < limit) {
+            size_t hit = FindNext(m_Folded.data(), m_Folded.size(), pos,
+                                  foldedQuery.data(), foldedQuery.size());
+            if (hit == npos) break;
+            // Names are '\0'-separated and queries never contain '\0', so a hit
+            // always lies inside exactly one row.
+            auto it = std::upper_bound(m_FoldedOffsets.begin(), m_FoldedOffsets.end(), (uint32_t)hit);
+            uint32_t row = (uint32_t)(it - m_FoldedOffsets.begin() - 1);
+            rows.push_back(row);
+            pos = m_FoldedOffsets[row + 1];
+        }
+        return rows;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace NameSearch {
+
+    // Case-folds UTF-8 for matching: ASCII and Latin-1 letters are lowercased and
+    // curly apostrophes become '. Anything else passes through unchanged.
+    void Fold(std::string_view in, std::string& out);
+
+    // Immutable name index: every folded name lives in one contiguous blob so a
+    // query is a single vectorized substring scan instead of a per-name lowercase
+    // and find. Rebuilt and republished whole when the catalog changes.
+    class Index {
+    public:
+        // Entries must be sorted by id; that order is the result order.
+        explicit Index(const std::vector<std::pair<int, std::string>>& entries);
+
+        size_t           Size() const { return m_Ids.size(); }
+        int              Id(size_t row)   const { return m_Ids[row]; }
+        // NUL-terminated original name.
+        const char*      Name(size_t row) const { return m_Names.data() + m_NameOffsets[row]; }
+        std::string_view FoldedName(size_t row) const
+        {
+            return std::string_view(m_Folded.data() + m_FoldedOffsets[row],
+                                    m_FoldedOffsets[row + 1] - m_FoldedOffsets[row] - 1);
+        }
+        // Row holding `id`, or -1.
+        int              RowOf(int id) const;
+
+        // Rows whose folded name contains the folded query, up to `limit`.
+        std::vector<uint32_t> Find(std::string_view foldedQuery, size_t limit) const;
+
+    private:
+        std::string           m_Folded;        // folded names, each followed by '\0'
+        std::vector<uint32_t> m_FoldedOffsets; // start of each row in m_Folded, plus end sentinel
+        std::string           m_Names;
+        std::vector<uint32_t> m_NameOffsets;
+        std::vector<int>      m_Ids;
+    };
+
+    // Search hits as rows into the index snapshot they came from. Keeps that
+    // snapshot alive, so names stay valid even if a newer index is published.
+    class Results {
+    public:
+        Results() = default;
+        Results(std::shared_ptr<const Index> index, std::vector<uint32_t> rows)
+            : m_Index(std::move(index)), m_Rows(std::move(rows)) {}
+
+        size_t      size()  const { return m_Rows.size(); }
+        bool        empty() const { return m_Rows.empty(); }
+        void        clear()       { m_Rows.clear(); m_Index.reset(); }
+        int         Id(size_t i)   const { return m_Index->Id(m_Rows[i]); }
+        const char* Name(size_t i) const { return m_Index->Name(m_Rows[i]); }
+
+    private:
+        std::shared_ptr<const Index> m_Index;
+        std::vector<uint32_t>        m_Rows;
+    };
+}
@@ -0,0 +1,71 @@
+#include "RefreshScheduler.h"
+#include <algorithm>
+
+RefreshScheduler::RefreshScheduler(const Config& config, uint32_t seed)
+    : m_Config(config), m_Rng(seed), m_Interval(config.BaseInterval)
+{
+}
+
+void RefreshScheduler::Schedule(double now, double gap)
+{
+    std::uniform_real_distribution<double> jitter(-m_Config.Jitter, m_Config.Jitter);
+    gap *= 1.0 + jitter(m_Rng);
+    double due = now + gap;
+    if (m_LastRequest >= 0.0) {
+        due = std::max(due, m_LastRequest + m_Config.MinInterval);
+        due = std::min(due, m_LastRequest + m_Config.MaxInterval);
+    }
+    m_Due = due;
+}
+
+bool RefreshScheduler::Tick(const Signals& s)
+{
+    if (!s.InGame) {
+        m_WasInGame = false;
+        m_LastTick  = -1.0;
+        return false;
+    }
+
+    // The old policy polled on entering the game and every LegacyInterval after
+    if (m_LastTick >= 0.0) m_Stats.PlaySeconds += s.Now - m_LastTick;
+    m_LastTick = s.Now;
+    if (!m_WasInGame || s.Now >= m_LegacyDue) {
+        ++m_Stats.LegacyRequests;
+        m_LegacyDue = s.Now + m_Config.LegacyInterval;
+    }
+
+    bool entered = !m_WasInGame;
+    m_WasInGame  = true;
+    if (entered && m_LastRequest < 0.0) {
+        m_Due = s.Now;
+    } else if (s.MapId != m_MapId) {
+        Schedule(s.Now, m_Config.MapChangeDelay);
+        m_MapChangePending = true;
+    }
+    m_MapId = s.MapId;
+
+    if (s.Now < m_Due) return false;
+
+    ++m_Stats.Requests;
+    m_LastRequest      = s.Now;
+    m_MapChangePending = false;
+    m_Idle = !s.Moving || !(s.UiState & UiState_GameHasFocus);
+    Schedule(s.Now, m_Interval * (m_Idle ? m_Config.IdleFactor : 1.0));
+    return true;
+}
+
+void RefreshScheduler::OnResult(bool changed)
+{
+    m_Interval = changed ? m_Config.BaseInterval
+                         : std::min(m_Interval * m_Config.Backoff, m_Config.MaxInterval);
+    // Re-plan the pending poll with the new interval unless a map change moved it up
+    if (m_LastRequest >= 0.0 && !m_MapChangePending)
+        Schedule(m_LastRequest, m_Interval * (m_Idle ? m_Config.IdleFactor : 1.0));
+}
+
+void RefreshScheduler::OnManualRequest(double now)
+{
+    m_LastRequest = now;
+    m_Interval    = m_Config.BaseInterval;
+    Schedule(now, m_Interval);
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <random>
+
+// Decides when to poll account progress. Pure policy: it never reads a clock or
+// the game itself; the caller feeds it the time and MumbleLink-derived signals
+// every frame and reports back whether each poll found anything new.
+//
+// The API mostly publishes progress on map changes, so a map change schedules a
+// poll shortly after. Otherwise the interval starts at BaseInterval, grows by
+// Backoff after every poll that found nothing and snaps back after one that
+// did; an idle or unfocused player stretches it further. Every gap gets a bit
+// of jitter and is clamped to [MinInterval, MaxInterval].
+class RefreshScheduler {
+public:
+    struct Config {
+        double MinInterval    = 10.0;   // seconds; hard floor between polls
+        double MaxInterval    = 300.0;  // hard ceiling
+        double BaseInterval   = 30.0;
+        double Backoff        = 1.5;
+        double IdleFactor     = 2.0;    // not moving or game unfocused
+        double MapChangeDelay = 5.0;    // give the API a moment to catch up
+        double Jitter         = 0.1;    // +- fraction of each gap
+        double LegacyInterval = 30.0;   // the fixed timer this replaces, for Stats
+    };
+
+    struct Signals {
+        double   Now     = 0.0;   // seconds, monotonic
+        bool     InGame  = false;
+        uint32_t MapId   = 0;
+        uint32_t UiState = 0;     // Mumble::Context::UiState bits
+        bool     Moving  = false;
+    };
+
+    struct Stats {
+        uint64_t Requests       = 0;
+        uint64_t LegacyRequests = 0;  // what the fixed timer would have sent over the same play time
+        double   PlaySeconds    = 0.0;
+        double   SavedPerHour() const
+        {
+            return PlaySeconds > 0.0 ? ((double)LegacyRequests - (double)Requests) * 3600.0 / PlaySeconds : 0.0;
+        }
+    };
+
+    static constexpr uint32_t UiState_GameHasFocus = 1u << 3;
+
+    RefreshScheduler() : RefreshScheduler(Config{}, 0) {}
+    RefreshScheduler(const Config& config, uint32_t seed);
+
+    // True when a poll should be sent now; the poll counts as sent.
+    bool Tick(const Signals& s);
+    // Reports whether the last poll changed anything.
+    void OnResult(bool changed);
+    // A poll sent outside the schedule (user action); restarts the interval.
+    void OnManualRequest(double now);
+
+    double       NextDue()  const { return m_Due; }
+    double       Interval() const { return m_Interval; }
+    const Stats& GetStats() const { return m_Stats; }
+
+private:
+    void   Schedule(double now, double gap);
+
+    Config       m_Config;
+    std::mt19937 m_Rng;
+    Stats        m_Stats;
+
+    double   m_Interval    = 0.0;
+    double   m_Due         = 0.0;
+    double   m_LastRequest = -1.0;   // < 0: never polled
+    double   m_LastTick    = -1.0;
+    double   m_LegacyDue   = 0.0;
+    bool     m_WasInGame   = false;
+    bool     m_Idle        = false;
+    bool     m_MapChangePending = false;
+    uint32_t m_MapId       = 0;
+};
@@ -0,0 +1,189 @@
+#include "RequestScheduler.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <random>
+
+namespace RequestScheduler {
+
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int    MAX_RETRIES   = 4;
+    static constexpr double BACKOFF_BASE  = 1.0;    // seconds before the first retry
+    static constexpr double BACKOFF_MAX   = 60.0;
+    // Share of a bucket the icon and background lanes leave for the lanes above them
+    static constexpr double LOW_LANE_RESERVE = 0.1;
+
+    struct Host {
+        Limits            Limit;
+        double            Tokens   = 0.0;
+        Clock::time_point Refilled = Clock::now();
+        Clock::time_point PausedUntil;
+        uint64_t          Waiting[RequestLane_Count] = {};
+    };
+
+    static std::mutex                  s_Mutex;
+    static std::condition_variable     s_Cv;
+    static std::map<std::string, Host> s_Hosts;
+    static bool                        s_Stopped = false;
+    static Stats                       s_Stats;
+    static std::mt19937                s_Rng(std::random_device{}());
+
+    static double Seconds(Clock::duration d)
+    {
+        return std::chrono::duration<double>(d).count();
+    }
+
+    static Clock::duration Duration(double seconds)
+    {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+
+    static void Refill(Host& h, Clock::time_point now)
+    {
+        if (h.Limit.Burst <= 0.0) return;
+        h.Tokens   = std::min(h.Limit.Burst, h.Tokens + Seconds(now - h.Refilled) * h.Limit.PerSecond);
+        h.Refilled = now;
+    }
+
+    // Blocks until `lane` may send one request to `h`; false once stopped.
+    static bool Acquire(std::unique_lock<std::mutex>& lock, Host& h, RequestLane lane)
+    {
+        ++h.Waiting[lane];
+        bool granted = false;
+        while (!s_Stopped) {
+            Clock::time_point now = Clock::now();
+            Refill(h, now);
+            bool ahead = false;
+            for (int l = 0; l < lane; ++l) ahead |= h.Waiting[l] > 0;
+            if (ahead) { s_Cv.wait(lock); continue; }
+            if (now < h.PausedUntil) { s_Cv.wait_until(lock, h.PausedUntil); continue; }
+            if (h.Limit.Burst <= 0.0) { granted = true; break; }
+
+            double need = 1.0 + (lane >= RequestLane_Icon ? h.Limit.Burst * LOW_LANE_RESERVE : 0.0);
+            if (h.Tokens >= need) {
+                h.Tokens -= 1.0;
+                granted = true;
+                break;
+            }
+            double wait = (need - h.Tokens) / std::max(h.Limit.PerSecond, 0.01);
+            s_Cv.wait_until(lock, now + Duration(wait));
+        }
+        --h.Waiting[lane];
+        // Lower lanes may have been held back by this one
+        s_Cv.notify_all();
+        return granted;
+    }
+
+    static MetricTimer EndpointTimer(const std::string& host, const std::string& path)
+    {
+        auto startsWith = [&](const char* prefix) { return path.rfind(prefix, 0) == 0; };
+        if (host == Http::RenderHost)               return MetricTimer_HttpIcons;
+        if (startsWith("/v2/achievements"))         return MetricTimer_HttpAchievements;
+        if (startsWith("/v2/items"))                return MetricTimer_HttpItems;
+        if (startsWith("/v2/account/achievements")) return MetricTimer_HttpAccount;
+        return MetricTimer_HttpOther;
+    }
+
+    static bool Retryable(int status)
+    {
+        return status == 0 || status == 429 || status == 500 || status == 502 ||
+               status == 503 || status == 504;
+    }
+
+    void Start()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        s_Stopped = false;
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_Stopped = true;
+        }
+        s_Cv.notify_all();
+    }
+
+    void SetLimits(const std::string& host, const Limits& limits)
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        Host& h = s_Hosts[host];
+        h.Limit    = limits;
+        h.Tokens   = limits.Burst;
+        h.Refilled = Clock::now();
+    }
+
+    int Get(RequestLane lane, const std::string& host, const std::string& path,
+            const std::string& bearerToken, HttpResponse& resp)
+    {
+        resp.Status = 0;
+        std::shared_ptr<HttpTransport> transport = Http::GetTransport();
+        if (!transport) return 0;
+
+        for (int attempt = 0;; ++attempt) {
+            {
+                std::unique_lock<std::mutex> lock(s_Mutex);
+                if (!Acquire(lock, s_Hosts[host], lane)) {
+                    resp.Status = 0;
+                    resp.Body.clear();
+                    return 0;
+                }
+                ++s_Stats.Sent;
+            }
+
+            int status;
+            {
+                Metrics::ScopedTimer timer(EndpointTimer(host, path));
+                Trace::Span span("http", "GET", path);
+                status = transport->Get(host, path, bearerToken, resp);
+            }
+            Metrics::Add(MetricCounter_HttpRequests);
+            Metrics::Add(MetricCounter_HttpBytes, resp.Body.size());
+            if (status < 200 || status >= 300) Metrics::Add(MetricCounter_HttpErrors);
+            if (!Retryable(status)) return status;
+
+            std::unique_lock<std::mutex> lock(s_Mutex);
+            if (status == 429) ++s_Stats.Throttled;
+            if (attempt >= MAX_RETRIES) {
+                ++s_Stats.Failed;
+                return status;
+            }
+            ++s_Stats.Retried;
+
+            double backoff = std::min(BACKOFF_BASE * (double)(1 << attempt), BACKOFF_MAX);
+            backoff *= std::uniform_real_distribution<double>(0.5, 1.0)(s_Rng);
+            double delay = resp.RetryAfter > 0 ? (double)resp.RetryAfter : backoff;
+            Clock::time_point until = Clock::now() + Duration(delay);
+
+            if (status == 429) {
+                // The limit is per account and IP, so the whole host waits, not just this request
+                Host& h = s_Hosts[host];
+                h.PausedUntil = std::max(h.PausedUntil, until);
+                h.Tokens      = 0.0;
+                h.Refilled    = Clock::now();
+            } else {
+                s_Cv.wait_until(lock, until, []() { return s_Stopped; });
+            }
+        }
+    }
+
+    Stats GetStats()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        Stats stats = s_Stats;
+        for (const auto& kv : s_Hosts)
+            for (int l = 0; l < RequestLane_Count; ++l) stats.Waiting[l] += kv.second.Waiting[l];
+        auto api = s_Hosts.find(Http::ApiHost);
+        if (api != s_Hosts.end()) {
+            Refill(api->second, Clock::now());
+            stats.ApiTokens = api->second.Tokens;
+        }
+        return stats;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "HttpTransport.h"
+#include <cstdint>
+#include <string>
+
+// Priority lanes, highest first. A request only goes out while no request of a
+// higher lane waits for the same host.
+enum RequestLane : uint8_t {
+    RequestLane_User,        // the user just tracked or opened something
+    RequestLane_Progress,    // account progress polls
+    RequestLane_Icon,
+    RequestLane_Background,  // catalog sync
+    RequestLane_Count
+};
+
+// Every outbound request goes through here. Each host gets a token bucket sized
+// to its rate limit; a 429 drains the bucket and pauses the host for Retry-After
+// (or an exponential backoff), and 5xx or dropped connections are retried with
+// backoff. Calls block the calling thread until the request is done or given up.
+namespace RequestScheduler {
+
+    struct Limits {
+        double Burst     = 0.0;   // bucket size; 0 means unlimited
+        double PerSecond = 0.0;   // refill rate
+    };
+
+    struct Stats {
+        uint64_t Sent      = 0;   // attempts handed to the transport, retries included
+        uint64_t Retried   = 0;
+        uint64_t Throttled = 0;   // 429 responses
+        uint64_t Failed    = 0;   // given up after the last retry
+        uint64_t Waiting[RequestLane_Count] = {};
+        double   ApiTokens = 0.0; // tokens left in the API host's bucket
+    };
+
+    void Start();
+    // Fails every waiting and future request fast until the next Start.
+    void Stop();
+
+    void SetLimits(const std::string& host, const Limits& limits);
+
+    // Sends the request through Http::GetTransport() and returns the final status;
+    // 0 if it never got a response or the scheduler was stopped.
+    int Get(RequestLane lane, const std::string& host, const std::string& path,
+            const std::string& bearerToken, HttpResponse& resp);
+
+    Stats GetStats();
+}
@@ -0,0 +1,149 @@
+#include "SearchService.h"
+#include "GW2Api.h"
+#include "Trace.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SearchService {
+
+    static constexpr size_t RESULT_LIMIT = 50;
+    // Above this many candidates, filtering them costs about as much as a fresh search
+    static constexpr size_t MAX_NARROW_CANDIDATES = 1500;
+
+    static std::thread             s_Thread;
+    static std::mutex              s_Mutex;
+    static std::condition_variable s_Cv;
+    static bool                    s_Running    = false;
+    static std::string             s_Pending;
+    static uint64_t                s_PendingGen = 0;   // bumped by every Submit
+    static uint64_t                s_StartedGen = 0;   // last generation the worker picked up
+    static uint64_t                s_DoneGen    = 0;   // generation s_Done belongs to
+    static uint64_t                s_TakenGen   = 0;   // last generation handed to Poll
+    static NameSearch::Results     s_Done;
+    static std::shared_ptr<std::atomic<bool>> s_Cancel;  // token of the newest query
+
+    // Worker-only record of the last search that ran to completion
+    struct Previous {
+        bool             Valid   = false;
+        std::string      Folded;
+        std::vector<int> Matched;
+        uint64_t         DataGen = 0;
+    };
+
+    static bool IsWordChar(unsigned char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c >= 0x80 || c == '\'';
+    }
+
+    bool CanNarrow(const std::string& previous, size_t previousMatches, const std::string& next)
+    {
+        if (previous.empty() || previousMatches > MAX_NARROW_CANDIDATES) return false;
+        if (next.size() < previous.size() || next.compare(0, previous.size(), previous) != 0)
+            return false;
+        if (next.size() == previous.size() || !IsWordChar((unsigned char)next[previous.size()]))
+            return true;
+        size_t tail = 0;
+        for (size_t i = previous.size(); i-- > 0 && IsWordChar((unsigned char)previous[i]); )
+            if (previous[i] != '\'') ++tail;
+        return tail == 0 || tail >= 3;
+    }
+
+    static void Worker()
+    {
+        Trace::SetThreadName("Search");
+        Previous prev;
+        std::unique_lock<std::mutex> lock(s_Mutex);
+        for (;;) {
+            s_Cv.wait(lock, []() { return !s_Running || s_PendingGen != s_StartedGen; });
+            if (!s_Running) break;
+
+            std::string query  = s_Pending;
+            uint64_t    gen    = s_PendingGen;
+            auto        cancel = s_Cancel;
+            s_StartedGen = gen;
+            lock.unlock();
+
+            Trace::Span span("search", "Query", query);
+            NameSearch::Results results;
+            std::string folded;
+            NameSearch::Fold(query, folded);
+            if (folded.empty()) {
+                prev.Valid = false;
+            } else {
+                uint64_t dataGen = GW2Api::SearchGeneration();
+                bool narrow = prev.Valid && prev.DataGen == dataGen &&
+                              CanNarrow(prev.Folded, prev.Matched.size(), folded);
+                std::vector<int> matched;
+                GW2Api::SearchRequest req;
+                req.Within  = narrow ? &prev.Matched : nullptr;
+                req.Matched = &matched;
+                req.Cancel  = cancel.get();
+                results = GW2Api::SearchAchievements(query, RESULT_LIMIT, req);
+                if (!*cancel) {
+                    prev.Valid   = true;
+                    prev.Folded  = folded;
+                    prev.Matched = std::move(matched);
+                    prev.DataGen = dataGen;
+                }
+            }
+
+            lock.lock();
+            if (!*cancel && gen == s_PendingGen) {
+                s_Done    = std::move(results);
+                s_DoneGen = gen;
+            }
+        }
+    }
+
+    void Start()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        if (s_Running) return;
+        s_Running = true;
+        s_Thread  = std::thread(Worker);
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            if (!s_Running) return;
+            s_Running = false;
+            if (s_Cancel) *s_Cancel = true;
+        }
+        s_Cv.notify_all();
+        if (s_Thread.joinable()) s_Thread.join();
+        s_Done.clear();
+    }
+
+    void Submit(const std::string& query)
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            if (s_Cancel) *s_Cancel = true;
+            s_Cancel  = std::make_shared<std::atomic<bool>>(false);
+            s_Pending = query;
+            ++s_PendingGen;
+        }
+        s_Cv.notify_one();
+    }
+
+    bool Poll(NameSearch::Results& out)
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        if (s_DoneGen == s_TakenGen) return false;
+        s_TakenGen = s_DoneGen;
+        out = s_Done;
+        return true;
+    }
+
+    bool IsBusy()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        return s_DoneGen != s_PendingGen;
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "NameSearch.h"
+#include <string>
+
+// Runs achievement searches on a background thread so typing never blocks the
+// frame. Each Submit supersedes (and cancels) the previous query; the render
+// thread picks up finished result sets with Poll.
+namespace SearchService {
+    void Start();
+    void Stop();
+
+    void Submit(const std::string& query);
+    // Swaps in the newest finished result set; false if nothing new since the last call.
+    bool Poll(NameSearch::Results& out);
+    // True while the latest submitted query has not finished yet.
+    bool IsBusy();
+
+    // Whether the matches of folded query `previous` still contain every match
+    // of `next`, and are few enough that narrowing them beats a fresh search.
+    // Extending a query can only shrink its match set, except when it grows a
+    // 1-2 character word into one long enough for infix matching.
+    bool CanNarrow(const std::string& previous, size_t previousMatches, const std::string& next);
+}
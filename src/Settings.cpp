@@ -1,12 +1,30 @@
 #include "Settings.h"
 #include "Shared.h"
+#include "Trace.h"
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
+namespace fs = std::filesystem;
 
 Settings g_Settings;
 
+// A slider drag calls Save every frame; the writer folds everything within this into one write
+static constexpr std::chrono::seconds WRITE_INTERVAL(2);
+
+static std::mutex                s_WriteMutex;
+static std::condition_variable   s_WriteCv;
+static std::thread               s_Writer;
+static bool                      s_Stopping = false;
+static std::unique_ptr<Settings> s_Pending;   // newest values not written yet
+static std::string               s_Path;
+
 static std::string SettingsPath()
 {
     return std::string(APIDefs->Paths_GetAddonDirectory("AchievementTracker")) + "settings.json";
@@ -14,13 +32,17 @@ static std::string SettingsPath()
 
 void Settings::Load()
 {
-    std::ifstream f(SettingsPath());
+    s_Path = SettingsPath();
+    std::ifstream f(s_Path);
     if (!f.is_open()) return;
     try {
         json j = json::parse(f);
         ShowWindow = j.value("ShowWindow", ShowWindow);
         Opacity    = j.value("Opacity",    Opacity);
         ApiKey     = j.value("ApiKey",     ApiKey);
+        SyncRequests = j.value("SyncRequests", SyncRequests);
+        IconCacheMB  = j.value("IconCacheMB",  IconCacheMB);
+        TraceEnabled = j.value("TraceEnabled", TraceEnabled);
         if (j.contains("TrackedAchievements") && j["TrackedAchievements"].is_array()) {
             TrackedAchievements = j["TrackedAchievements"].get<std::vector<int>>();
         }
@@ -35,16 +57,79 @@ void Settings::Load()
     } catch (...) {}
 }
 
-void Settings::Save()
+static void Write(const Settings& s)
 {
+    Trace::Span span("cache", "WriteSettings");
     json j;
-    j["ShowWindow"]          = ShowWindow;
-    j["Opacity"]             = Opacity;
-    j["ApiKey"]              = ApiKey;
-    j["TrackedAchievements"] = TrackedAchievements;
+    j["ShowWindow"]          = s.ShowWindow;
+    j["Opacity"]             = s.Opacity;
+    j["ApiKey"]              = s.ApiKey;
+    j["SyncRequests"]        = s.SyncRequests;
+    j["IconCacheMB"]         = s.IconCacheMB;
+    j["TraceEnabled"]        = s.TraceEnabled;
+    j["TrackedAchievements"] = s.TrackedAchievements;
     j["CollapsedHeaders"]    = json::array();
-    for (int id : CollapsedHeaders) j["CollapsedHeaders"].push_back(id);
+    for (int id : s.CollapsedHeaders) j["CollapsedHeaders"].push_back(id);
     j["CollapsedDetails"]    = json::array();
-    for (int id : CollapsedDetails) j["CollapsedDetails"].push_back(id);
-    std::ofstream(SettingsPath()) << j.dump(4);
+    for (int id : s.CollapsedDetails) j["CollapsedDetails"].push_back(id);
+
+    // Write-then-rename, so a crash mid-write leaves the previous file intact
+    std::string tmp = s_Path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::trunc);
+        f << j.dump(4);
+        if (!f.good()) return;
+    }
+    std::error_code ec;
+    fs::rename(tmp, s_Path, ec);
+    if (ec) fs::remove(tmp, ec);
+}
+
+static void Writer()
+{
+    Trace::SetThreadName("SettingsWriter");
+    auto lastWrite = std::chrono::steady_clock::time_point{};
+    std::unique_lock<std::mutex> lock(s_WriteMutex);
+    for (;;) {
+        s_WriteCv.wait(lock, []() { return s_Stopping || s_Pending; });
+        if (s_Stopping) break;
+        s_WriteCv.wait_until(lock, lastWrite + WRITE_INTERVAL, []() { return s_Stopping; });
+        if (s_Stopping) break;
+
+        std::unique_ptr<Settings> pending = std::move(s_Pending);
+        lock.unlock();
+        Write(*pending);
+        lastWrite = std::chrono::steady_clock::now();
+        lock.lock();
+    }
+}
+
+void Settings::Save()
+{
+    {
+        std::lock_guard<std::mutex> lock(s_WriteMutex);
+        if (s_Path.empty()) return;
+        // Reuses the pending copy's allocations when the writer has not taken it yet
+        if (!s_Pending) s_Pending = std::make_unique<Settings>();
+        *s_Pending = *this;
+        if (!s_Writer.joinable()) {
+            s_Stopping = false;
+            s_Writer   = std::thread(Writer);
+        }
+    }
+    s_WriteCv.notify_one();
+}
+
+void Settings::Flush()
+{
+    {
+        std::lock_guard<std::mutex> lock(s_WriteMutex);
+        s_Stopping = true;
+    }
+    s_WriteCv.notify_one();
+    if (s_Writer.joinable()) s_Writer.join();
+
+    std::lock_guard<std::mutex> lock(s_WriteMutex);
+    if (s_Pending) Write(*s_Pending);
+    s_Pending.reset();
 }
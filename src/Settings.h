@@ -7,12 +7,19 @@ struct Settings {
     bool  ShowWindow   = true;
     float Opacity      = 1.0f;
     std::string ApiKey;
+    int   SyncRequests = 4;  // concurrent batch requests during a full catalog download
+    int   IconCacheMB  = 64; // on-disk icon cache budget
+    bool  TraceEnabled = false; // record spans from startup on, for Trace::Write
     std::vector<int> TrackedAchievements;
     std::unordered_set<int> CollapsedHeaders; // achievement IDs whose top header is collapsed
     std::unordered_set<int> CollapsedDetails; // achievement IDs whose Details section is collapsed
 
     void Load();
+    // Queues the current values for a background writer that saves at most once
+    // per interval; never touches the disk on the calling thread.
     void Save();
+    // Writes whatever is still queued and stops the writer. Called on unload.
+    void Flush();
 };
 
 extern Settings g_Settings;
@@ -35,7 +35,7 @@ namespace Mumble {
         Vector3  CameraTop;
         wchar_t  Identity[256];
         uint32_t ContextLength;
-        Context  Context;
+        Mumble::Context Context;
         wchar_t  Description[2048];
     };
     struct Identity {
@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// Versioned, immutable id -> T table. Writers copy the current version, apply
+// their change and publish the copy as the next generation; readers grab the
+// current version with one atomic load, so they never wait while a writer copies.
+// That load is not lock-free: the standard library guards atomic shared_ptr
+// access with a small pool of locks held only for the pointer swap. Everything a
+// reader gets from a version stays valid for as long as it holds that version.
+template <typename T>
+class SnapshotTable {
+public:
+    using Entries = std::map<int, std::shared_ptr<const T>>;
+
+    struct Version {
+        uint64_t Generation = 0;
+        Entries  Items;
+
+        const T* Find(int id) const
+        {
+            auto it = Items.find(id);
+            return it != Items.end() ? it->second.get() : nullptr;
+        }
+        std::shared_ptr<const T> FindShared(int id) const
+        {
+            auto it = Items.find(id);
+            return it != Items.end() ? it->second : nullptr;
+        }
+    };
+
+    SnapshotTable() : m_Current(std::make_shared<const Version>()) {}
+
+    std::shared_ptr<const Version> Load() const
+    {
+        return std::atomic_load_explicit(&m_Current, std::memory_order_acquire);
+    }
+
+    // Runs `mutate(Entries&)` on a private copy and publishes it. Writers are
+    // serialized against each other only. Returns the new generation.
+    template <typename Fn>
+    uint64_t Update(Fn&& mutate)
+    {
+        std::lock_guard<std::mutex> lock(m_WriteMutex);
+        auto next = std::make_shared<Version>(*Load());
+        ++next->Generation;
+        mutate(next->Items);
+        uint64_t gen = next->Generation;
+        std::atomic_store_explicit(&m_Current, std::shared_ptr<const Version>(std::move(next)),
+                                   std::memory_order_release);
+        return gen;
+    }
+
+    // Like Update, but `mutate(Entries&)` returns whether it changed anything and
+    // the copy is only published if it did. Returns whether it was.
+    template <typename Fn>
+    bool UpdateIfChanged(Fn&& mutate)
+    {
+        std::lock_guard<std::mutex> lock(m_WriteMutex);
+        auto next = std::make_shared<Version>(*Load());
+        if (!mutate(next->Items)) return false;
+        ++next->Generation;
+        std::atomic_store_explicit(&m_Current, std::shared_ptr<const Version>(std::move(next)),
+                                   std::memory_order_release);
+        return true;
+    }
+
+    // Publishes `entries` wholesale, skipping the copy of the old version.
+    uint64_t Replace(Entries entries)
+    {
+        std::lock_guard<std::mutex> lock(m_WriteMutex);
+        auto next = std::make_shared<Version>();
+        next->Generation = Load()->Generation + 1;
+        next->Items      = std::move(entries);
+        uint64_t gen = next->Generation;
+        std::atomic_store_explicit(&m_Current, std::shared_ptr<const Version>(std::move(next)),
+                                   std::memory_order_release);
+        return gen;
+    }
+
+private:
+    std::shared_ptr<const Version> m_Current;
+    std::mutex                     m_WriteMutex;
+};
@@ -0,0 +1,77 @@
+#include "StringPool.h"
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace StringPool {
+
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    static std::mutex                           s_Mutex;
+    static std::vector<std::unique_ptr<char[]>> s_Blocks;
+    static char*                                s_Current    = nullptr;  // block being filled
+    static size_t                               s_Used       = BLOCK_SIZE;
+    static size_t                               s_BlockBytes = 0;
+    static std::unordered_set<std::string_view> s_Strings;  // views into s_Blocks
+
+    static char* NewBlock(size_t size)
+    {
+        s_Blocks.emplace_back(new char[size]);
+        s_BlockBytes += size;
+        return s_Blocks.back().get();
+    }
+
+    // Copies `s` plus a terminator into the arena; caller holds s_Mutex.
+    static const char* Store(std::string_view s)
+    {
+        size_t need = s.size() + 1;
+        char* dst;
+        if (need > BLOCK_SIZE / 4) {
+            // Long strings get a block of their own rather than wasting the current one
+            dst = NewBlock(need);
+        } else {
+            if (s_Used + need > BLOCK_SIZE) {
+                s_Current = NewBlock(BLOCK_SIZE);
+                s_Used    = 0;
+            }
+            dst = s_Current + s_Used;
+            s_Used += need;
+        }
+        std::memcpy(dst, s.data(), s.size());
+        dst[s.size()] = '\0';
+        return dst;
+    }
+
+    static std::string_view Intern(std::string_view s)
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        auto it = s_Strings.find(s);
+        if (it != s_Strings.end()) return *it;
+        std::string_view stored(Store(s), s.size());
+        s_Strings.insert(stored);
+        return stored;
+    }
+
+    size_t Count()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        return s_Strings.size();
+    }
+
+    size_t Bytes()
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        // Rough hash set overhead: one node plus one bucket pointer per string
+        return s_BlockBytes + s_Strings.size() * (sizeof(std::string_view) + 3 * sizeof(void*));
+    }
+}
+
+PooledString::PooledString(std::string_view s)
+{
+    if (s.empty()) return;
+    std::string_view stored = StringPool::Intern(s);
+    m_Data = stored.data();
+    m_Size = (uint32_t)stored.size();
+}
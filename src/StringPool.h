@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Handle to an immutable, NUL-terminated string in the process-wide pool.
+// Equal strings share one copy, so the many achievements and bits repeating the
+// same text cost a pointer each. Pooled strings live until the addon unloads.
+class PooledString {
+public:
+    PooledString() = default;
+    explicit PooledString(std::string_view s);
+
+    const char*      c_str() const { return m_Data; }
+    size_t           size()  const { return m_Size; }
+    bool             empty() const { return m_Size == 0; }
+    std::string_view view()  const { return std::string_view(m_Data, m_Size); }
+    operator std::string_view() const { return view(); }
+
+    // Pooled strings are unique, so equal contents mean equal pointers. Empty
+    // strings are not pooled and may point at different "" literals.
+    bool operator==(const PooledString& o) const
+    {
+        return m_Size == o.m_Size && (m_Size == 0 || m_Data == o.m_Data);
+    }
+    bool operator!=(const PooledString& o) const { return !(*this == o); }
+
+private:
+    const char* m_Data = "";
+    uint32_t    m_Size = 0;
+};
+
+namespace StringPool {
+    // Distinct strings held and the bytes reserved for them, bookkeeping included.
+    size_t Count();
+    size_t Bytes();
+}
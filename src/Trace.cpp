@@ -0,0 +1,137 @@
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace Trace {
+
+    struct Event {
+        std::atomic<uint64_t> Seq{0};   // index + 1 once complete; 0 while being written
+        const char* Category = nullptr;
+        const char* Name     = nullptr;
+        uint32_t    Thread   = 0;
+        int64_t     StartNs  = 0;
+        int64_t     DurNs    = 0;
+        char        Detail[48] = {};
+    };
+
+    static const auto                 s_Epoch = std::chrono::steady_clock::now();
+    static std::unique_ptr<Event[]>   s_Ring(new Event[CAPACITY]);
+    static std::atomic<uint64_t>      s_Head{0};
+    static std::atomic<uint32_t>      s_NextThread{1};
+    static std::mutex                 s_NamesMutex;
+    static std::map<uint32_t, std::string> s_ThreadNames;
+
+    static int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - s_Epoch).count();
+    }
+
+    static uint32_t ThreadId()
+    {
+        thread_local uint32_t id = s_NextThread.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    void SetEnabled(bool enabled)
+    {
+        g_Enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void SetThreadName(const char* name)
+    {
+        std::lock_guard<std::mutex> lock(s_NamesMutex);
+        s_ThreadNames[ThreadId()] = name;
+    }
+
+    size_t EventCount()
+    {
+        return (size_t)std::min<uint64_t>(s_Head.load(std::memory_order_relaxed), CAPACITY);
+    }
+
+    Span::Span(const char* category, const char* name, const char* detail)
+        : m_Category(category), m_Name(name)
+    {
+        if (!IsEnabled()) return;
+        m_Detail[0] = '\0';
+        if (detail) {
+            std::strncpy(m_Detail, detail, sizeof(m_Detail) - 1);
+            m_Detail[sizeof(m_Detail) - 1] = '\0';
+        }
+        m_StartNs = NowNs();
+    }
+
+    Span::~Span()
+    {
+        if (m_StartNs < 0) return;
+        int64_t end = NowNs();
+
+        // Claim a slot, mark it incomplete, fill it, then publish its sequence number.
+        // A reader that sees the same sequence before and after copying got a whole event.
+        uint64_t idx = s_Head.fetch_add(1, std::memory_order_relaxed);
+        Event& e = s_Ring[idx % CAPACITY];
+        e.Seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        e.Category = m_Category;
+        e.Name     = m_Name;
+        e.Thread   = ThreadId();
+        e.StartNs  = m_StartNs;
+        e.DurNs    = end - m_StartNs;
+        std::memcpy(e.Detail, m_Detail, sizeof(e.Detail));
+        e.Seq.store(idx + 1, std::memory_order_release);
+    }
+
+    bool Write(const std::string& path)
+    {
+        struct Copy {
+            const char* Category;
+            const char* Name;
+            uint32_t    Thread;
+            int64_t     StartNs, DurNs;
+            char        Detail[48];
+        };
+        std::vector<Copy> events;
+        uint64_t head  = s_Head.load(std::memory_order_acquire);
+        uint64_t first = head > CAPACITY ? head - CAPACITY : 0;
+        events.reserve((size_t)(head - first));
+        for (uint64_t i = first; i < head; ++i) {
+            const Event& e = s_Ring[i % CAPACITY];
+            if (e.Seq.load(std::memory_order_acquire) != i + 1) continue;
+            Copy c{ e.Category, e.Name, e.Thread, e.StartNs, e.DurNs, {} };
+            std::memcpy(c.Detail, e.Detail, sizeof(c.Detail));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (e.Seq.load(std::memory_order_relaxed) != i + 1) continue;   // overwritten meanwhile
+            c.Detail[sizeof(c.Detail) - 1] = '\0';
+            events.push_back(c);
+        }
+
+        json trace = json::array();
+        {
+            std::lock_guard<std::mutex> lock(s_NamesMutex);
+            for (const auto& kv : s_ThreadNames)
+                trace.push_back({ { "ph", "M" }, { "name", "thread_name" }, { "pid", 1 },
+                                  { "tid", kv.first }, { "args", { { "name", kv.second } } } });
+        }
+        for (const Copy& c : events) {
+            json ev = { { "ph", "X" }, { "cat", c.Category }, { "name", c.Name }, { "pid", 1 },
+                        { "tid", c.Thread }, { "ts", c.StartNs / 1000.0 }, { "dur", c.DurNs / 1000.0 } };
+            if (c.Detail[0]) ev["args"] = { { "detail", c.Detail } };
+            trace.push_back(std::move(ev));
+        }
+
+        std::ofstream f(path, std::ios::trunc);
+        // A detail cut mid-character is not valid UTF-8; replace rather than throw
+        f << json{ { "traceEvents", std::move(trace) }, { "displayTimeUnit", "ms" } }
+                 .dump(-1, ' ', false, json::error_handler_t::replace);
+        return f.good();
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Opt-in span recorder for profiling startup and sync in a trace viewer
+// (chrome://tracing, ui.perfetto.dev). Finished spans go into a fixed-size,
+// lock-free ring that keeps the newest events; Write exports them as Chrome
+// trace-event JSON. While disabled a span costs one relaxed load.
+namespace Trace {
+
+    // Events kept; older ones are overwritten.
+    constexpr size_t CAPACITY = 1 << 16;
+
+    void SetEnabled(bool enabled);
+    inline std::atomic<bool> g_Enabled{false};
+    inline bool IsEnabled() { return g_Enabled.load(std::memory_order_relaxed); }
+
+    // Labels the calling thread in exported traces. `name` is copied.
+    void SetThreadName(const char* name);
+
+    // Writes every recorded span as trace-event JSON; false if the file could not be written.
+    bool Write(const std::string& path);
+    size_t EventCount();
+
+    // `category` and `name` must be string literals; `detail` (truncated to 47
+    // bytes) is copied and shows up as the span's argument.
+    class Span {
+    public:
+        Span(const char* category, const char* name, const char* detail = nullptr);
+        Span(const char* category, const char* name, const std::string& detail)
+            : Span(category, name, detail.c_str()) {}
+        ~Span();
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        const char* m_Category;
+        const char* m_Name;
+        int64_t     m_StartNs = -1;   // -1 when tracing was off at construction
+        char        m_Detail[48];
+    };
+}
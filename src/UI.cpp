@@ -2,9 +2,20 @@
 #include "Shared.h"
 #include "Settings.h"
 #include "GW2Api.h"
+#include "AchievementView.h"
+#include "HttpTransport.h"
+#include "RequestScheduler.h"
+#include "IconPipeline.h"
+#include "IconCache.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include "SearchService.h"
+#include "RefreshScheduler.h"
 #include <imgui.h>
 #include <algorithm>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <shellapi.h>
@@ -35,7 +46,9 @@ namespace UI {
     }
 
     static char  s_SearchBuf[256] = "";
-    static std::vector<Achievement> s_SearchResults;
+    static NameSearch::Results s_SearchResults;
+    static int         s_SearchIdHit = 0;     // numeric query: the id typed, known or not
+    static std::string s_SearchIdLabel;
     static bool  s_SearchDirty = false;
 
     static bool        s_ShowDeleteConfirm = false;
@@ -43,8 +56,31 @@ namespace UI {
     static std::string s_PendingDeleteName;
     static ImVec2      s_DeleteConfirmPos  = {};
 
-    static double s_LastProgressRefresh = 0.0;
-    static bool   s_WasInGame           = false;
+    static RefreshScheduler s_ProgressScheduler(RefreshScheduler::Config{}, (uint32_t)GetTickCount());
+    static uint64_t s_ProgressFetchesSeen = 0;
+    static float    s_LastAvatarPos[3]    = {};
+    static double   s_LastMovedAt         = -1e9;  // ImGui time the avatar position last changed
+    // MumbleLink updates slower than frames render, so movement is judged over a window
+    static constexpr double MOVING_WINDOW = 3.0;
+    static uint32_t s_RefreshedForBuild   = 0;
+
+    struct Toast {
+        std::string Text;
+        double      Expires;
+    };
+    static std::vector<Toast> s_Toasts;
+    static constexpr double   TOAST_SECONDS = 6.0;
+    static constexpr size_t   MAX_TOASTS    = 4;
+
+    static constexpr int   GRID_COLUMNS = 8;
+    static constexpr float ICON_SIZE    = 32.0f;
+
+    // Height each tracked achievement took when last drawn; while that space is off
+    // screen the row is stepped over instead of submitted
+    static std::unordered_map<int, float> s_RowHeights;
+
+    static bool                    s_CategoryTreeRequested = false;
+    static std::unordered_set<int> s_RequestedCategories;  // open categories whose load was asked for
 
     static int         s_TooltipItemId = 0;
     static const Item* s_TooltipItem   = nullptr;
@@ -60,8 +96,8 @@ namespace UI {
     static void RefreshProgress()
     {
         if (!g_Settings.ApiKey.empty() && !g_Settings.TrackedAchievements.empty()) {
-            GW2Api::FetchAccountAchievementsAsync(g_Settings.ApiKey);
-            s_LastProgressRefresh = ImGui::GetTime();
+            GW2Api::FetchTrackedProgressAsync(g_Settings.ApiKey, g_Settings.TrackedAchievements);
+            s_ProgressScheduler.OnManualRequest(ImGui::GetTime());
         }
     }
 
@@ -78,30 +114,96 @@ namespace UI {
     {
         auto& v = g_Settings.TrackedAchievements;
         v.erase(std::remove(v.begin(), v.end(), id), v.end());
+        s_RowHeights.erase(id);
         g_Settings.Save();
     }
 
-    static void RunSearch()
+    static void ClearSearch()
     {
+        SearchService::Submit("");
         s_SearchResults.clear();
+        s_SearchIdHit = 0;
+        s_SearchIdLabel.clear();
+    }
+
+    // Text queries go to the search worker; results arrive via SearchService::Poll.
+    static void RunSearch()
+    {
         std::string q(s_SearchBuf);
-        if (q.empty()) return;
-
-        bool isNumeric = !q.empty() && std::all_of(q.begin(), q.end(), ::isdigit);
-        if (isNumeric) {
-            int id = std::stoi(q);
-            const Achievement* ach = GW2Api::GetAchievement(id);
-            if (ach) {
-                s_SearchResults.push_back(*ach);
-            } else {
-                Achievement stub;
-                stub.id   = id;
-                stub.name = "Achievement #" + q;
-                s_SearchResults.push_back(stub);
+        bool isNumeric = !q.empty() && q.size() < 10 && std::all_of(q.begin(), q.end(), ::isdigit);
+        if (q.empty() || isNumeric) {
+            ClearSearch();
+            if (isNumeric) {
+                s_SearchIdHit = std::stoi(q);
+                const Achievement* ach = GW2Api::AcquireSnapshot().FindAchievement(s_SearchIdHit);
+                s_SearchIdLabel = ach ? ach->name : "Achievement #" + q;
             }
         } else {
-            s_SearchResults = GW2Api::SearchAchievements(q);
+            s_SearchIdHit = 0;
+            SearchService::Submit(q);
+        }
+    }
+
+    // One selectable achievement line, green once tracked; returns true when it was clicked to track.
+    static bool RenderTrackableRow(int id, const char* name)
+    {
+        bool tracked = IsTracked(id);
+        if (tracked) ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f,0.9f,0.5f,1));
+        ImGui::PushID(id);
+        bool sel = ImGui::Selectable(name);
+        ImGui::PopID();
+        if (tracked) ImGui::PopStyleColor();
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip(tracked ? "Already tracked" : "Click to track");
+        if (!sel || tracked) return false;
+        TrackAchievement(id);
+        return true;
+    }
+
+    // Groups and categories as the game's panel lists them. A category's
+    // achievements are fetched the first time it is opened and show as they arrive.
+    static void RenderBrowse(const GW2Api::Snapshot& snap)
+    {
+        if (!ImGui::TreeNodeEx("Browse categories", ImGuiTreeNodeFlags_SpanAvailWidth)) return;
+
+        auto tree = GW2Api::GetCategoryTree();
+        if (!tree) {
+            if (!s_CategoryTreeRequested) {
+                GW2Api::FetchCategoryTreeAsync();
+                s_CategoryTreeRequested = true;
+            }
+            if (GW2Api::IsLoadingCategoryTree()) {
+                ImGui::TextDisabled("Loading categories...");
+            } else {
+                ImGui::TextDisabled("Categories unavailable.");
+                ImGui::SameLine();
+                if (ImGui::SmallButton("Retry")) s_CategoryTreeRequested = false;
+            }
+            ImGui::TreePop();
+            return;
         }
+
+        ImGui::BeginChild("##browse", ImVec2(0, 200.0f), true);
+        for (const AchievementGroup& group : tree->Groups) {
+            if (!ImGui::TreeNode(group.id.c_str(), "%s", group.name.c_str())) continue;
+            for (int catId : group.categories) {
+                const AchievementCategory* cat = tree->FindCategory(catId);
+                if (!ImGui::TreeNode((void*)(intptr_t)catId, "%s", cat->name.c_str())) {
+                    s_RequestedCategories.erase(catId);  // reopening retries what failed
+                    continue;
+                }
+                if (s_RequestedCategories.insert(catId).second) GW2Api::LoadCategoryAsync(catId);
+                for (int id : cat->achievements) {
+                    const Achievement* ach = snap.FindAchievement(id);
+                    if (ach) RenderTrackableRow(id, ach->name.c_str());
+                }
+                if (GW2Api::IsCategoryLoading(catId)) ImGui::TextDisabled("Loading...");
+                ImGui::TreePop();
+            }
+            ImGui::TreePop();
+        }
+        ImGui::EndChild();
+        ImGui::TreePop();
     }
 
     static void DrawItemTooltip(const Item* item, int itemId, void* tex)
@@ -163,17 +265,125 @@ namespace UI {
         }
     }
 
-    static void RenderAchievement(int id, bool& removed)
+    static void RenderAchievementBody(AchievementView::View& view)
     {
-        const Achievement*        ach    = GW2Api::GetAchievement(id);
-        const AccountAchievement* accAch = GW2Api::GetAccountAchievement(id);
+        const int id = view.Id;
+        const Achievement* ach = view.Ach.get();
+
+        // Cache-backed entries carry only the summary until first shown
+        if (!ach->details_loaded) {
+            GW2Api::RequestDetailsAsync(id);
+            ImGui::TextDisabled("Loading...");
+            return;
+        }
+
+        bool textCollapsed = g_Settings.CollapsedDetails.count(id) > 0;
+
+        ImGuiTreeNodeFlags textFlags = ImGuiTreeNodeFlags_SpanAvailWidth;
+        if (!textCollapsed) textFlags |= ImGuiTreeNodeFlags_DefaultOpen;
+        bool textOpen = ImGui::TreeNodeEx("Details", textFlags);
+
+        if (textOpen  &&  textCollapsed) { g_Settings.CollapsedDetails.erase(id);  g_Settings.Save(); }
+        if (!textOpen && !textCollapsed) { g_Settings.CollapsedDetails.insert(id); g_Settings.Save(); }
+        if (textOpen) {
+            ImGui::TextWrapped("%s", ach->description.c_str());
+            if (!ach->requirement.empty())
+                ImGui::TextWrapped("%s", ach->requirement.c_str());
+            ImGui::TreePop();
+        }
+
+        if (!view.ProgressText.empty()) {
+            ImGui::ProgressBar((float)view.Progress->current / (float)view.Progress->max,
+                               ImVec2(-1, 0), view.ProgressText.c_str());
+        }
+
+        if (view.Bits.empty()) return;
+
+        ImGui::Spacing();
 
-        std::string headerLabel = ach ? ach->name : "Achievement #" + std::to_string(id);
-        headerLabel += "##ach" + std::to_string(id);
+        if (view.Mode == AchievementView::Layout_List) {
+            // List layout for text-only achievements; one line each, so only visible ones are submitted
+            ImGuiListClipper clipper;
+            clipper.Begin((int)view.Bits.size(), ImGui::GetTextLineHeightWithSpacing());
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                    bool isDone = view.IsDone(i);
+                    ImVec4 col = isDone ? ImVec4(0.4f,1.0f,0.4f,1) : ImVec4(0.55f,0.55f,0.55f,1);
+                    // Strikethrough-style: dim + bullet prefix when done, dash when not
+                    const char* bullet = isDone ? "\xE2\x97\x8F " : "- ";
+                    ImGui::TextColored(col, "%s%s", bullet, view.Bits[i].Text.c_str());
+                }
+            }
+        } else if (ImGui::BeginTable("bits", GRID_COLUMNS)) {
+            // Grid layout for icon-based achievements. Every row is held to icon
+            // height, text-only or not, so the clipper can skip rows it cannot see.
+            const float rowH = ICON_SIZE + ImGui::GetStyle().CellPadding.y * 2.0f;
+            const int   rows = (int)((view.Bits.size() + GRID_COLUMNS - 1) / GRID_COLUMNS);
+            ImGuiListClipper clipper;
+            clipper.Begin(rows, rowH);
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    ImGui::TableNextRow(ImGuiTableRowFlags_None, rowH);
+                    size_t end = std::min(view.Bits.size(), (size_t)(row + 1) * GRID_COLUMNS);
+                    for (size_t i = (size_t)row * GRID_COLUMNS; i < end; ++i) {
+                        ImGui::TableNextColumn();
+                        AchievementView::Bit& bit = view.Bits[i];
+                        bool isDone = view.IsDone(i);
+
+                        if (bit.Type == BitType_Item) {
+                            const Item* item = bit.ItemInfo.get();
+                            if (!bit.Tex) bit.Tex = GetTexResource(bit.TexName);
+
+                            // Only icons actually on screen get queued, top rows first
+                            if (!bit.Tex && item && !item->icon.empty() && ImGui::IsRectVisible(ImVec2(ICON_SIZE, ICON_SIZE)))
+                                IconPipeline::Request(item->icon, bit.TexName);
+
+                            if (bit.Tex) {
+                                ImGui::PushID((int)i);
+                                ImVec4 tint = isDone ? ImVec4(1,1,1,1) : ImVec4(0.3f,0.3f,0.3f,1.f);
+                                ImGui::Image((ImTextureID)bit.Tex, ImVec2(ICON_SIZE, ICON_SIZE),
+                                             ImVec2(0,0), ImVec2(1,1), tint);
+
+                                if (ImGui::IsItemHovered()) {
+                                    s_TooltipItemId = bit.Id;
+                                    s_TooltipItem   = item;
+                                    s_TooltipTex    = bit.Tex;
+                                }
+
+                                if (ImGui::BeginPopupContextItem("##ctx")) {
+                                    std::string wikiLbl = item
+                                        ? ("Open Wiki: " + item->name)
+                                        : ("Open Wiki: Item #" + std::to_string(bit.Id));
+                                    if (ImGui::MenuItem(wikiLbl.c_str())) {
+                                        std::string wikiName = item ? item->name : std::to_string(bit.Id);
+                                        OpenURL(WikiURL(wikiName));
+                                    }
+                                    ImGui::EndPopup();
+                                }
+                                ImGui::PopID();
+                            } else {
+                                ImVec4 col = isDone ? ImVec4(0.8f,0.8f,0.8f,1) : ImVec4(0.4f,0.4f,0.4f,1);
+                                ImGui::TextColored(col, "%s", bit.Label.c_str());
+                            }
+                        } else if (bit.Type == BitType_Text) {
+                            ImVec4 col = isDone ? ImVec4(0.4f,1.0f,0.4f,1) : ImVec4(0.5f,0.5f,0.5f,1);
+                            ImGui::TextColored(col, "%s", bit.Text.c_str());
+                        }
+                    }
+                }
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    static void RenderAchievement(const GW2Api::Snapshot& snap, int id, bool& removed)
+    {
+        AchievementView::View& view = AchievementView::Get(snap, id);
+        const Achievement* ach = view.Ach.get();
 
         // Restore persisted collapse state on first render in this session
         ImGui::SetNextItemOpen(!g_Settings.CollapsedHeaders.count(id), ImGuiCond_Once);
-        bool open = ImGui::CollapsingHeader(headerLabel.c_str(),
+        bool open = ImGui::CollapsingHeader(view.HeaderLabel.c_str(),
                         ImGuiTreeNodeFlags_AllowItemOverlap);
 
         // Persist any user-triggered collapse/expand
@@ -191,13 +401,14 @@ namespace UI {
         float totalBtnW = wikiW + ImGui::GetStyle().ItemSpacing.x + btnW;
         ImGui::SameLine(ImGui::GetContentRegionAvail().x + ImGui::GetCursorPosX() - totalBtnW);
 
-        if (ImGui::SmallButton(("W##wiki" + std::to_string(id)).c_str())) {
+        ImGui::PushID(id);
+        if (ImGui::SmallButton("W")) {
             if (ach) OpenURL(WikiURL(ach->name));
         }
         if (ImGui::IsItemHovered()) ImGui::SetTooltip("Open Wiki page");
 
         ImGui::SameLine();
-        if (ImGui::SmallButton(("X##rm" + std::to_string(id)).c_str())) {
+        if (ImGui::SmallButton("X")) {
             s_PendingDeleteId   = id;
             s_PendingDeleteName = ach ? ach->name : "Achievement #" + std::to_string(id);
             s_ShowDeleteConfirm = true;
@@ -205,110 +416,49 @@ namespace UI {
         }
         if (ImGui::IsItemHovered()) ImGui::SetTooltip("Stop tracking");
 
-        if (!open || !ach) return;
-
-        bool textCollapsed = g_Settings.CollapsedDetails.count(id) > 0;
-
-        ImGuiTreeNodeFlags textFlags = ImGuiTreeNodeFlags_SpanAvailWidth;
-        if (!textCollapsed) textFlags |= ImGuiTreeNodeFlags_DefaultOpen;
-        bool textOpen = ImGui::TreeNodeEx(("Details##txt" + std::to_string(id)).c_str(), textFlags);
-
-        if (textOpen  &&  textCollapsed) { g_Settings.CollapsedDetails.erase(id);  g_Settings.Save(); }
-        if (!textOpen && !textCollapsed) { g_Settings.CollapsedDetails.insert(id); g_Settings.Save(); }
-        if (textOpen) {
-            ImGui::TextWrapped("%s", ach->description.c_str());
-            if (!ach->requirement.empty())
-                ImGui::TextWrapped("%s", ach->requirement.c_str());
-            ImGui::TreePop();
-        }
+        if (open && ach) RenderAchievementBody(view);
+        ImGui::PopID();
+    }
 
-        if (accAch && accAch->max > 0) {
-            std::string prog = std::to_string(accAch->current) + "/" + std::to_string(accAch->max);
-            ImGui::ProgressBar((float)accAch->current / (float)accAch->max,
-                               ImVec2(-1, 0), prog.c_str());
+    static std::string ToastText(const ProgressEvent& ev, const GW2Api::Snapshot& snap)
+    {
+        const Achievement* ach = snap.FindAchievement(ev.Id);
+        std::string name = ach ? ach->name : "Achievement #" + std::to_string(ev.Id);
+        switch (ev.Type) {
+        case ProgressEvent::Kind_Completed:
+            return "Completed: " + name;
+        case ProgressEvent::Kind_TierReached:
+            return name + ": tier " + std::to_string(ev.Count) + " reached";
+        default:
+            return name + ": " + std::to_string(ev.Count) + (ev.Count == 1 ? " new step" : " new steps") +
+                   (ev.Max > 0 ? " (" + std::to_string(ev.Current) + "/" + std::to_string(ev.Max) + ")" : "");
         }
+    }
 
-        if (ach->bits.empty()) return;
-
-        // Decide whether to use a list layout (all bits are text-only) or the icon grid
-        bool allText = true;
-        for (const auto& bit : ach->bits) {
-            if (bit.type != "Text") { allText = false; break; }
+    static void DrawToasts()
+    {
+        std::vector<ProgressEvent> events = GW2Api::TakeProgressEvents();
+        double now = ImGui::GetTime();
+        if (!events.empty()) {
+            GW2Api::Snapshot snap = GW2Api::AcquireSnapshot();
+            for (const auto& ev : events) s_Toasts.push_back({ ToastText(ev, snap), now + TOAST_SECONDS });
         }
-
-        ImGui::Spacing();
-
-        if (allText) {
-            // List layout for text-only achievements
-            for (size_t i = 0; i < ach->bits.size(); ++i) {
-                const auto& bit = ach->bits[i];
-                bool isDone = false;
-                if (accAch)
-                    isDone = std::find(accAch->bits.begin(), accAch->bits.end(),
-                                       (int)i) != accAch->bits.end();
-                ImVec4 col = isDone ? ImVec4(0.4f,1.0f,0.4f,1) : ImVec4(0.55f,0.55f,0.55f,1);
-                // Strikethrough-style: dim + bullet prefix when done, dash when not
-                const char* bullet = isDone ? "\xE2\x97\x8F " : "- ";
-                ImGui::TextColored(col, "%s%s", bullet, bit.text.c_str());
-            }
-        } else {
-            // Grid layout for icon-based achievements
-            std::string tableId = "bits##" + std::to_string(id);
-            if (ImGui::BeginTable(tableId.c_str(), 8)) {
-                for (size_t i = 0; i < ach->bits.size(); ++i) {
-                    ImGui::TableNextColumn();
-                    const auto& bit = ach->bits[i];
-
-                    bool isDone = false;
-                    if (accAch)
-                        isDone = std::find(accAch->bits.begin(), accAch->bits.end(),
-                                           (int)i) != accAch->bits.end();
-
-                    if (bit.type == "Item") {
-                        const Item* item = GW2Api::GetItem(bit.id);
-                        std::string texName = "ITEM_ICON_" + std::to_string(bit.id);
-                        void* tex = GetTexResource(texName);
-
-                        // If icon isn't loaded yet, request it asynchronously
-                        if (!tex && item && !item->icon.empty())
-                            GW2Api::RequestIconAsync(item->icon, texName);
-
-                        if (tex) {
-                            ImGui::PushID((int)i + id * 10000);
-                            ImVec4 tint = isDone ? ImVec4(1,1,1,1) : ImVec4(0.3f,0.3f,0.3f,1.f);
-                            ImGui::Image((ImTextureID)tex, ImVec2(32,32),
-                                         ImVec2(0,0), ImVec2(1,1), tint);
-
-                            if (ImGui::IsItemHovered()) {
-                                s_TooltipItemId = bit.id;
-                                s_TooltipItem   = item;
-                                s_TooltipTex    = tex;
-                            }
-
-                            if (ImGui::BeginPopupContextItem("##ctx")) {
-                                std::string wikiLbl = item
-                                    ? ("Open Wiki: " + item->name)
-                                    : ("Open Wiki: Item #" + std::to_string(bit.id));
-                                if (ImGui::MenuItem(wikiLbl.c_str())) {
-                                    std::string wikiName = item ? item->name : std::to_string(bit.id);
-                                    OpenURL(WikiURL(wikiName));
-                                }
-                                ImGui::EndPopup();
-                            }
-                            ImGui::PopID();
-                        } else {
-                            std::string lbl = item ? item->name : "ID " + std::to_string(bit.id);
-                            ImVec4 col = isDone ? ImVec4(0.8f,0.8f,0.8f,1) : ImVec4(0.4f,0.4f,0.4f,1);
-                            ImGui::TextColored(col, "%s", lbl.c_str());
-                        }
-                    } else if (bit.type == "Text") {
-                        ImVec4 col = isDone ? ImVec4(0.4f,1.0f,0.4f,1) : ImVec4(0.5f,0.5f,0.5f,1);
-                        ImGui::TextColored(col, "%s", bit.text.c_str());
-                    }
-                }
-                ImGui::EndTable();
-            }
+        s_Toasts.erase(std::remove_if(s_Toasts.begin(), s_Toasts.end(),
+            [now](const Toast& t) { return t.Expires <= now; }), s_Toasts.end());
+        if (s_Toasts.size() > MAX_TOASTS) s_Toasts.erase(s_Toasts.begin(), s_Toasts.end() - MAX_TOASTS);
+        if (s_Toasts.empty()) return;
+
+        ImVec2 display = ImGui::GetIO().DisplaySize;
+        ImGui::SetNextWindowPos(ImVec2(display.x * 0.5f, display.y * 0.2f), ImGuiCond_Always, ImVec2(0.5f, 0.f));
+        ImGui::SetNextWindowBgAlpha(0.75f);
+        ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs |
+                                 ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings |
+                                 ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav;
+        if (ImGui::Begin("##AchievementToasts", nullptr, flags)) {
+            for (const auto& t : s_Toasts)
+                ImGui::TextColored(ImVec4(1.0f, 0.85f, 0.3f, 1.0f), "%s", t.Text.c_str());
         }
+        ImGui::End();
     }
 
     static void DrawDeleteConfirm()
@@ -344,21 +494,56 @@ namespace UI {
 
     void Render()
     {
+        Metrics::ScopedTimer frameTimer(MetricTimer_Frame);
+        Trace::Span frameSpan("render", "Render");
+        static bool s_ThreadNamed = false;
+        if (!s_ThreadNamed) { Trace::SetThreadName("Render"); s_ThreadNamed = true; }
 
         bool inGame = IsInGame();
         if (!g_Settings.ApiKey.empty() && !g_Settings.TrackedAchievements.empty()) {
-            double now = ImGui::GetTime();
-            bool justEntered = inGame && !s_WasInGame;
-            bool timerFired  = inGame && (now - s_LastProgressRefresh) > 30.0;
-            if (justEntered || timerFired) {
-                GW2Api::FetchAccountAchievementsAsync(g_Settings.ApiKey);
-                s_LastProgressRefresh = now;
+            GW2Api::ProgressSyncCounters sync = GW2Api::ProgressSyncStatus();
+            if (sync.Fetches != s_ProgressFetchesSeen) {
+                s_ProgressFetchesSeen = sync.Fetches;
+                s_ProgressScheduler.OnResult(sync.LastChanged);
+            }
+
+            RefreshScheduler::Signals sig;
+            sig.Now    = ImGui::GetTime();
+            sig.InGame = inGame;
+            if (MumbleLink) {
+                const auto& pos = MumbleLink->AvatarPosition;
+                sig.MapId   = MumbleLink->Context.MapId;
+                sig.UiState = MumbleLink->Context.UiState;
+                if (pos.X != s_LastAvatarPos[0] || pos.Y != s_LastAvatarPos[1] || pos.Z != s_LastAvatarPos[2])
+                    s_LastMovedAt = sig.Now;
+                s_LastAvatarPos[0] = pos.X; s_LastAvatarPos[1] = pos.Y; s_LastAvatarPos[2] = pos.Z;
+                sig.Moving  = sig.Now - s_LastMovedAt < MOVING_WINDOW;
             }
+            if (s_ProgressScheduler.Tick(sig))
+                GW2Api::FetchTrackedProgressAsync(g_Settings.ApiKey, g_Settings.TrackedAchievements);
         }
-        s_WasInGame = inGame;
+
+        // A new game build may have added achievements: top up the cache once per build
+        if (inGame && GW2Api::IsAchievementCacheLoaded() && !GW2Api::IsLoadingAllAchievements()) {
+            uint32_t build = MumbleLink->Context.BuildId;
+            if (build != 0 && build != s_RefreshedForBuild &&
+                build != GW2Api::AchievementCacheBuildId() &&
+                GW2Api::CachedAchievementCount() > 0)
+            {
+                s_RefreshedForBuild = build;
+                GW2Api::RefreshAchievementsAsync(g_Settings.SyncRequests);
+            }
+        }
+
+        if (inGame) DrawToasts();
 
         if (!g_Settings.ShowWindow || !inGame) return;
 
+        // One consistent view of the data for the whole frame; it also keeps the
+        // hovered item alive until the tooltip is drawn
+        const GW2Api::Snapshot snap = GW2Api::AcquireSnapshot();
+        IconPipeline::BeginFrame();
+
         DrawDeleteConfirm();
 
         ImGui::SetNextWindowSize(ImVec2(360, 500), ImGuiCond_FirstUseEver);
@@ -380,6 +565,7 @@ namespace UI {
             RunSearch();
             s_SearchDirty = false;
         }
+        SearchService::Poll(s_SearchResults);
 
         if (GW2Api::IsLoadingAllAchievements()) {
             ImGui::TextDisabled("(%d cached...)", GW2Api::CachedAchievementCount());
@@ -389,43 +575,67 @@ namespace UI {
 
         if (hasQuery) {
             ImGui::Separator();
-            if (s_SearchResults.empty()) {
-                if (GW2Api::IsLoadingAllAchievements())
+            size_t resultCount = s_SearchIdHit ? 1 : s_SearchResults.size();
+            if (resultCount == 0) {
+                if (SearchService::IsBusy())
+                    ImGui::TextDisabled("Searching...");
+                else if (GW2Api::IsLoadingAllAchievements())
                     ImGui::TextDisabled("Still loading... try again shortly.");
                 else
                     ImGui::TextDisabled("No results.");
             } else {
-                float childH = std::min((float)s_SearchResults.size() * 24.0f + 8.0f, 160.0f);
+                float childH = std::min((float)resultCount * 24.0f + 8.0f, 160.0f);
                 ImGui::BeginChild("##results", ImVec2(0, childH), true);
-                for (const auto& ach : s_SearchResults) {
-                    bool tracked = IsTracked(ach.id);
-                    if (tracked) ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f,0.9f,0.5f,1));
-                    bool sel = ImGui::Selectable((ach.name + "##sr" + std::to_string(ach.id)).c_str());
-                    if (tracked) ImGui::PopStyleColor();
-                    if (ImGui::IsItemHovered())
-                        ImGui::SetTooltip(tracked ? "Already tracked" : "Click to track");
-                    if (sel && !tracked) {
-                        TrackAchievement(ach.id);
-                        s_SearchBuf[0] = '\0';
-                        s_SearchResults.clear();
+                // Results can run into the thousands; only the rows in view are submitted
+                bool picked = false;
+                ImGuiListClipper clipper;
+                clipper.Begin((int)resultCount, ImGui::GetTextLineHeightWithSpacing());
+                while (!picked && clipper.Step()) {
+                    for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r) {
+                        int         resId   = s_SearchIdHit ? s_SearchIdHit : s_SearchResults.Id(r);
+                        const char* resName = s_SearchIdHit ? s_SearchIdLabel.c_str() : s_SearchResults.Name(r);
+                        if (RenderTrackableRow(resId, resName)) {
+                            picked = true;
+                            break;
+                        }
                     }
                 }
+                clipper.End();
+                if (picked) {
+                    s_SearchBuf[0] = '\0';
+                    ClearSearch();
+                }
                 ImGui::EndChild();
             }
             ImGui::Separator();
+        } else {
+            RenderBrowse(snap);
         }
 
         if (g_Settings.TrackedAchievements.empty()) {
-            ImGui::TextDisabled("No achievements tracked.\nSearch above to add one.");
+            ImGui::TextDisabled("No achievements tracked.\nSearch or browse above to add one.");
         } else {
             bool removedAny = false;
+            const float spacing = ImGui::GetStyle().ItemSpacing.y;
             for (size_t i = 0; i < g_Settings.TrackedAchievements.size(); ++i) {
+                int id = g_Settings.TrackedAchievements[i];
+                // Rows not drawn yet are measured; measured ones off screen keep their space only
+                auto height = s_RowHeights.find(id);
+                if (height != s_RowHeights.end() &&
+                    !ImGui::IsRectVisible(ImVec2(ImGui::GetContentRegionAvail().x, height->second)))
+                {
+                    ImGui::Dummy(ImVec2(0.0f, std::max(0.0f, height->second - spacing)));
+                    continue;
+                }
+                float top = ImGui::GetCursorPosY();
                 bool removed = false;
-                RenderAchievement(g_Settings.TrackedAchievements[i], removed);
-                if (removed) { --i; removedAny = true; }
+                RenderAchievement(snap, id, removed);
+                if (removed) { --i; removedAny = true; continue; }
+                s_RowHeights[id] = ImGui::GetCursorPosY() - top;
             }
             (void)removedAny;
         }
+        AchievementView::Prune(g_Settings.TrackedAchievements);
 
         ImGui::End();
 
@@ -437,6 +647,65 @@ namespace UI {
         }
     }
 
+    static void RenderMetrics()
+    {
+        Metrics::Snapshot m = Metrics::Collect();
+        ImGui::TextDisabled("HTTP: %llu requests, %.1f MB, %llu errors",
+                            (unsigned long long)m.Counters[MetricCounter_HttpRequests],
+                            m.Counters[MetricCounter_HttpBytes] / (1024.0 * 1024.0),
+                            (unsigned long long)m.Counters[MetricCounter_HttpErrors]);
+        ImGui::TextDisabled("Icon queue: %lld now, %lld peak",
+                            (long long)m.Gauges[MetricGauge_IconQueue],
+                            (long long)m.GaugePeaks[MetricGauge_IconQueue]);
+
+        if (ImGui::BeginTable("metrics", 6, ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Timer");
+            ImGui::TableSetupColumn("Count");
+            ImGui::TableSetupColumn("Avg ms");
+            ImGui::TableSetupColumn("p50 ms");
+            ImGui::TableSetupColumn("p95 ms");
+            ImGui::TableSetupColumn("Max ms");
+            ImGui::TableHeadersRow();
+            for (int t = 0; t < MetricTimer_Count; ++t) {
+                const Metrics::TimerStats& s = m.Timers[t];
+                if (s.Count == 0) continue;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(Metrics::Name((MetricTimer)t));
+                ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)s.Count);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", s.AvgMs());
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", s.PercentileMs(0.50));
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", s.PercentileMs(0.95));
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", s.MaxNs / 1e6);
+            }
+            ImGui::EndTable();
+        }
+
+        if (ImGui::Button("Dump Metrics")) {
+            std::string path = std::string(APIDefs->Paths_GetAddonDirectory("AchievementTracker")) + "metrics.json";
+            std::thread([path]() { Metrics::Dump(path); }).detach();
+        }
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("Writes all counters and latency histograms to metrics.json in the addon folder.");
+
+        if (ImGui::Checkbox("Record trace", &g_Settings.TraceEnabled)) {
+            Trace::SetEnabled(g_Settings.TraceEnabled);
+            g_Settings.Save();
+        }
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("Records HTTP, parsing, cache, texture, search and render spans.\n"
+                              "Stays on across restarts so startup can be captured too.");
+        if (Trace::EventCount() > 0) {
+            ImGui::SameLine();
+            if (ImGui::Button("Write Trace")) {
+                std::string path = std::string(APIDefs->Paths_GetAddonDirectory("AchievementTracker")) + "trace.json";
+                std::thread([path]() { Trace::Write(path); }).detach();
+            }
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("Saves the last %zu spans to trace.json; open it in ui.perfetto.dev or chrome://tracing.",
+                                  Trace::EventCount());
+        }
+    }
+
     void RenderOptions()
     {
         if (ImGui::Checkbox("Show Tracker", &g_Settings.ShowWindow))
@@ -462,10 +731,15 @@ namespace UI {
             g_Settings.Save();
         }
         if (ImGui::Button("Refresh Progress")) {
-            GW2Api::FetchAccountAchievementsAsync(g_Settings.ApiKey);
+            RefreshProgress();
         }
         if (ImGui::IsItemHovered())
-            ImGui::SetTooltip("Re-fetches your account achievement progress from the API.");
+            ImGui::SetTooltip("Re-fetches progress of your tracked achievements from the API.");
+        const RefreshScheduler::Stats& refresh = s_ProgressScheduler.GetStats();
+        if (refresh.PlaySeconds > 60.0)
+            ImGui::TextDisabled("Auto refresh every ~%.0fs; %llu requests, %.0f/h fewer than a fixed 30s timer",
+                                s_ProgressScheduler.Interval(), (unsigned long long)refresh.Requests,
+                                refresh.SavedPerHour());
 
         ImGui::Separator();
         ImGui::TextUnformatted("Achievement Data Cache");
@@ -487,6 +761,15 @@ namespace UI {
             ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f),
                 "Cache ready -- %d achievements", cached);
             ImGui::TextDisabled("Saved to disk. Loaded automatically on next launch.");
+            if (GW2Api::IsAchievementCacheLoaded())
+                ImGui::TextDisabled("Loaded from disk in %.1f ms", GW2Api::AchievementCacheLoadSeconds() * 1000.0);
+            GW2Api::CatalogMemory mem = GW2Api::CatalogMemoryUsage();
+            ImGui::TextDisabled("Memory: %.1f MB entries, %.1f MB shared text",
+                                mem.Entries / (1024.0 * 1024.0), mem.Strings / (1024.0 * 1024.0));
+            CatalogSync::Stats sync = GW2Api::LastCatalogSyncStats();
+            if (sync.Batches > 0)
+                ImGui::TextDisabled("Last download: %d batches in %.1fs (%.1f batches/s)",
+                                    sync.Batches, sync.WallSeconds, sync.BatchesPerSec);
         }
 
         ImGui::Spacing();
@@ -496,15 +779,67 @@ namespace UI {
             ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.3f,0.3f,0.3f,1));
             ImGui::PushStyleColor(ImGuiCol_ButtonActive,  ImVec4(0.3f,0.3f,0.3f,1));
         }
-        const char* btnLabel = (cached == 0) ? "Download Achievement Data" : "Refresh Cache";
-        if (ImGui::Button(btnLabel) && !loading)
-            GW2Api::FetchAllAchievementsAsync();
+        if (cached == 0) {
+            if (ImGui::Button("Download Achievement Data") && !loading)
+                GW2Api::FetchAllAchievementsAsync(g_Settings.SyncRequests);
+        } else {
+            if (ImGui::Button("Refresh Cache") && !loading)
+                GW2Api::RefreshAchievementsAsync(g_Settings.SyncRequests);
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("Downloads new achievements and re-checks a sample of cached ones.");
+            ImGui::SameLine();
+            if (ImGui::Button("Full Re-download") && !loading)
+                GW2Api::FetchAllAchievementsAsync(g_Settings.SyncRequests);
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("Re-downloads everything from the API.");
+        }
         if (loading) ImGui::PopStyleColor(3);
 
-        if (!loading && cached > 0) {
-            ImGui::SameLine();
-            ImGui::TextDisabled("(re-downloads everything from the API)");
+        if (ImGui::SliderInt("Parallel requests", &g_Settings.SyncRequests, 1, 8))
+            g_Settings.Save();
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("How many batches of achievement data are downloaded at once.");
+
+        if (auto transport = Http::GetTransport()) {
+            HttpTransportStats net = transport->Stats();
+            ImGui::TextDisabled("Network: %llu requests, %llu connections opened, %llu reused",
+                                (unsigned long long)net.Requests,
+                                (unsigned long long)net.ConnectionsOpened,
+                                (unsigned long long)net.ConnectionsReused);
         }
+        RequestScheduler::Stats sched = RequestScheduler::GetStats();
+        ImGui::TextDisabled("API budget: %.0f tokens; %llu retried, %llu throttled, %llu failed",
+                            sched.ApiTokens, (unsigned long long)sched.Retried,
+                            (unsigned long long)sched.Throttled, (unsigned long long)sched.Failed);
+        ImGui::TextDisabled("Waiting: %llu user, %llu progress, %llu icon, %llu background",
+                            (unsigned long long)sched.Waiting[RequestLane_User],
+                            (unsigned long long)sched.Waiting[RequestLane_Progress],
+                            (unsigned long long)sched.Waiting[RequestLane_Icon],
+                            (unsigned long long)sched.Waiting[RequestLane_Background]);
+        ImGui::SliderInt("Icon cache (MB)", &g_Settings.IconCacheMB, 8, 512);
+        // Applied on release, and evicting deletes files, so that runs on an icon worker
+        if (ImGui::IsItemDeactivatedAfterEdit()) {
+            IconCache::SetBudget((uint64_t)g_Settings.IconCacheMB << 20);
+            IconPipeline::Post(IconCache::Trim);
+            g_Settings.Save();
+        }
+        IconCache::Stats disk = IconCache::GetStats();
+        uint64_t lookups = disk.Hits + disk.Misses;
+        ImGui::TextDisabled("Icon cache: %zu files, %.1f MB, %.0f%% hits (%llu/%llu), %llu evicted",
+                            disk.Files, disk.Bytes / (1024.0 * 1024.0),
+                            lookups ? 100.0 * disk.Hits / lookups : 0.0,
+                            (unsigned long long)disk.Hits, (unsigned long long)lookups,
+                            (unsigned long long)disk.Evictions);
+        IconPipeline::Stats icons = IconPipeline::GetStats();
+        ImGui::TextDisabled("Icons: %d workers, %zu queued, %zu loaded, %zu cancelled, %zu failed",
+                            icons.Workers, icons.Queued, icons.Loaded, icons.Cancelled, icons.Failed);
+        if (icons.Loaded > 0)
+            ImGui::TextDisabled("First visible icon in %.0f ms, %.0f ms average",
+                                icons.FirstIconMs, icons.AvgLatencyMs);
+
+        ImGui::Separator();
+        ImGui::TextUnformatted("Performance");
+        RenderMetrics();
     }
 
 }
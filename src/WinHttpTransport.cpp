@@ -0,0 +1,163 @@
+#include "HttpTransport.h"
+#include <windows.h>
+#include <winhttp.h>
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+
+namespace {
+
+    // Set through the request context by the status callback once WinHTTP has
+    // opened a new socket for the request; stays false when it reused one.
+    void CALLBACK OnStatus(HINTERNET, DWORD_PTR context, DWORD status, LPVOID, DWORD)
+    {
+        if (status == WINHTTP_CALLBACK_STATUS_CONNECTED_TO_SERVER && context)
+            *reinterpret_cast<bool*>(context) = true;
+    }
+
+    // One WinHTTP session + connect handle per host. WinHTTP keeps the sockets
+    // behind a session alive on its own; we cap concurrent requests per host at the
+    // pool size so it never needs more than that many. Whether a request got a
+    // fresh connection is reported by WinHTTP's CONNECTED_TO_SERVER notification.
+    class WinHttpTransport : public HttpTransport {
+    public:
+        explicit WinHttpTransport(int maxConnectionsPerHost)
+            : m_MaxConns(std::max(1, maxConnectionsPerHost)) {}
+
+        ~WinHttpTransport() override
+        {
+            for (auto& kv : m_Hosts) {
+                if (kv.second->Connect) WinHttpCloseHandle(kv.second->Connect);
+                if (kv.second->Session) WinHttpCloseHandle(kv.second->Session);
+            }
+        }
+
+        using HttpTransport::Get;
+
+        int Get(const std::string& host, const std::string& path,
+                const std::string& bearerToken, HttpResponse& resp) override
+        {
+            resp.Status     = 0;
+            resp.RetryAfter = 0;
+            resp.Body.clear();  // keeps capacity
+            Host* h = AcquireSlot(host);
+            if (!h) return 0;
+
+            std::wstring wPath(path.begin(), path.end());
+            HINTERNET hReq = WinHttpOpenRequest(h->Connect, L"GET", wPath.c_str(),
+                nullptr, WINHTTP_NO_REFERER, WINHTTP_DEFAULT_ACCEPT_TYPES, WINHTTP_FLAG_SECURE);
+
+            if (hReq && !bearerToken.empty()) {
+                std::wstring auth = L"Authorization: Bearer ";
+                auth += std::wstring(bearerToken.begin(), bearerToken.end());
+                WinHttpAddRequestHeaders(hReq, auth.c_str(), (DWORD)-1, WINHTTP_ADDREQ_FLAG_ADD);
+            }
+
+            bool connected = false;
+            bool sent = hReq && WinHttpSendRequest(hReq, WINHTTP_NO_ADDITIONAL_HEADERS, 0,
+                                                   WINHTTP_NO_REQUEST_DATA, 0, 0, (DWORD_PTR)&connected);
+            if (sent) CountConnection(connected);
+            if (sent && WinHttpReceiveResponse(hReq, nullptr))
+            {
+                DWORD status = 0, sz = sizeof(status);
+                WinHttpQueryHeaders(hReq,
+                    WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
+                    WINHTTP_HEADER_NAME_BY_INDEX, &status, &sz, WINHTTP_NO_HEADER_INDEX);
+                resp.Status = (int)status;
+
+                // Only the delta-seconds form; an HTTP date fails the numeric query and leaves 0
+                DWORD retryAfter = 0;
+                sz = sizeof(retryAfter);
+                if (WinHttpQueryHeaders(hReq, WINHTTP_QUERY_RETRY_AFTER | WINHTTP_QUERY_FLAG_NUMBER,
+                        WINHTTP_HEADER_NAME_BY_INDEX, &retryAfter, &sz, WINHTTP_NO_HEADER_INDEX))
+                    resp.RetryAfter = (int)retryAfter;
+
+                DWORD avail = 0;
+                while (WinHttpQueryDataAvailable(hReq, &avail) && avail > 0) {
+                    size_t old = resp.Body.size();
+                    resp.Body.resize(old + avail);
+                    DWORD read = 0;
+                    WinHttpReadData(hReq, &resp.Body[old], avail, &read);
+                    resp.Body.resize(old + read);
+                }
+            }
+            if (hReq) WinHttpCloseHandle(hReq);
+
+            ReleaseSlot(h);
+            return resp.Status;
+        }
+
+        HttpTransportStats Stats() const override
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            return m_Stats;
+        }
+
+    private:
+        struct Host {
+            HINTERNET               Session = nullptr;
+            HINTERNET               Connect = nullptr;
+            int                     InUse   = 0;
+            std::condition_variable Cv;
+        };
+
+        Host* AcquireSlot(const std::string& name)
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            auto& slot = m_Hosts[name];
+            if (!slot) {
+                slot = std::make_unique<Host>();
+                slot->Session = WinHttpOpen(L"AchievementTracker/1.0",
+                    WINHTTP_ACCESS_TYPE_DEFAULT_PROXY, WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
+                if (slot->Session) {
+                    DWORD maxConns = (DWORD)m_MaxConns;
+                    WinHttpSetOption(slot->Session, WINHTTP_OPTION_MAX_CONNS_PER_SERVER,
+                                     &maxConns, sizeof(maxConns));
+                    // Inherited by the connect and request handles made from it
+                    WinHttpSetStatusCallback(slot->Session, OnStatus,
+                                             WINHTTP_CALLBACK_FLAG_CONNECT_TO_SERVER, 0);
+                    std::wstring wHost(name.begin(), name.end());
+                    slot->Connect = WinHttpConnect(slot->Session, wHost.c_str(),
+                                                   INTERNET_DEFAULT_HTTPS_PORT, 0);
+                }
+            }
+            Host* h = slot.get();
+            if (!h->Connect) return nullptr;
+
+            h->Cv.wait(lock, [&]() { return h->InUse < m_MaxConns; });
+            ++m_Stats.Requests;
+            ++h->InUse;
+            return h;
+        }
+
+        void CountConnection(bool opened)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (opened) ++m_Stats.ConnectionsOpened;
+            else        ++m_Stats.ConnectionsReused;
+        }
+
+        void ReleaseSlot(Host* h)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                --h->InUse;
+            }
+            h->Cv.notify_one();
+        }
+
+        const int                                    m_MaxConns;
+        mutable std::mutex                           m_Mutex;
+        std::map<std::string, std::unique_ptr<Host>> m_Hosts;
+        HttpTransportStats                           m_Stats;
+    };
+}
+
+namespace Http {
+
+    std::shared_ptr<HttpTransport> CreateWinHttpTransport(int maxConnectionsPerHost)
+    {
+        return std::make_shared<WinHttpTransport>(maxConnectionsPerHost);
+    }
+}
@@ -2,6 +2,12 @@
 #include "Settings.h"
 #include "UI.h"
 #include "GW2Api.h"
+#include "HttpTransport.h"
+#include "RequestScheduler.h"
+#include "SearchService.h"
+#include "IconPipeline.h"
+#include "IconCache.h"
+#include "Trace.h"
 #include <imgui.h>
 #include <cstring>
 #include <thread>
@@ -29,8 +35,26 @@ static void AddonLoad(AddonAPI_t* aApi)
     MumbleIdent = static_cast<Mumble::Identity*>(aApi->DataLink_Get(DL_MUMBLE_LINK_IDENTITY));
 
     g_Settings.Load();
+    Trace::SetEnabled(g_Settings.TraceEnabled);
+    Http::SetTransport(Http::CreateWinHttpTransport(6));
+    // The API allows bursts of 300 requests per key and IP, refilling at 5 per second
+    RequestScheduler::SetLimits(Http::ApiHost,    { 300.0, 5.0 });
+    RequestScheduler::SetLimits(Http::RenderHost, { 50.0, 20.0 });
+    RequestScheduler::Start();
+    SearchService::Start();
+    std::string iconsDir = std::string(aApi->Paths_GetAddonDirectory("AchievementTracker")) + "icons\\";
+    CreateDirectoryA(iconsDir.c_str(), nullptr);
+    IconCache::Open(iconsDir, (uint64_t)g_Settings.IconCacheMB << 20);
+    IconPipeline::Start(4, GW2Api::LoadIcon);
 
-    g_CacheThread = std::thread([]() { GW2Api::LoadAchievementCache(); });
+    // Stale-while-revalidate: the tracker first draws whatever the caches hold,
+    // then the init thread swaps in only what the API reports as changed
+    g_CacheThread = std::thread([tracked = g_Settings.TrackedAchievements, apiKey = g_Settings.ApiKey]() {
+        Trace::SetThreadName("CacheLoad");
+        GW2Api::LoadCaches(tracked, apiKey);
+        // Whatever the cached catalog links to, so browsing it never waits for item names
+        GW2Api::PrefetchItemsAsync();
+    });
 
     aApi->GUI_Register(RT_Render, UI::Render);
     aApi->GUI_Register(RT_OptionsRender, UI::RenderOptions);
@@ -40,27 +64,9 @@ static void AddonLoad(AddonAPI_t* aApi)
     aApi->QuickAccess_Add("QA_ACHIEVEMENT_TRACKER", "ICON_ACHIEVEMENT_TRACKER", "ICON_ACHIEVEMENT_TRACKER",
                           "KB_ACHIEVEMENT_TRACKER_TOGGLE", "Achievement Tracker");
 
-    g_InitThread = std::thread([]() {
-        if (!g_Settings.TrackedAchievements.empty()) {
-            GW2Api::FetchAchievements(g_Settings.TrackedAchievements);
-            std::vector<int> itemIds;
-            for (int id : g_Settings.TrackedAchievements) {
-                const Achievement* ach = GW2Api::GetAchievement(id);
-                if (ach) {
-                    for (const auto& bit : ach->bits) {
-                        if (bit.type == "Item") {
-                            itemIds.push_back(bit.id);
-                        }
-                    }
-                }
-            }
-            if (!itemIds.empty()) {
-                GW2Api::FetchItems(itemIds);
-            }
-            GW2Api::LoadTextures();
-        }
-        if (!g_Settings.ApiKey.empty() && !g_Settings.TrackedAchievements.empty())
-            GW2Api::FetchAccountAchievementsAsync(g_Settings.ApiKey);
+    g_InitThread = std::thread([tracked = g_Settings.TrackedAchievements, apiKey = g_Settings.ApiKey]() {
+        Trace::SetThreadName("Init");
+        GW2Api::RevalidateTracked(tracked, apiKey);
     });
 }
 
@@ -69,8 +75,14 @@ static void AddonUnload()
     if (!APIDefs) return;
     
     GW2Api::Shutdown();
+    RequestScheduler::Stop();
+    SearchService::Stop();
+    IconPipeline::Stop();
+    IconCache::Close();
     if (g_CacheThread.joinable()) g_CacheThread.join();
     if (g_InitThread.joinable())  g_InitThread.join();
+    g_Settings.Flush();
+    Http::SetTransport(nullptr);
 
     APIDefs->GUI_Deregister(UI::Render);
     APIDefs->GUI_Deregister(UI::RenderOptions);